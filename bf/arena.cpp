@@ -0,0 +1,92 @@
+/*
+ * arena.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: gianni
+ *
+ * BitForge http://www.bitforge.com.br
+ * Copyright (c) 2012 All Right Reserved,
+ */
+
+#include "arena.h"
+
+#include <algorithm>
+
+namespace bitforge
+{
+
+thread_local Arena* Arena::s_current = nullptr;
+
+Arena::Arena(std::size_t chunkSize): m_chunkSize(chunkSize)
+{
+}
+
+Arena::~Arena()
+{
+    freeChunks(m_chunks);
+}
+
+void Arena::freeChunks(Chunk* chunk)
+{
+    while (chunk)
+    {
+        Chunk* next = chunk->next;
+        ::operator delete(chunk);
+        chunk = next;
+    }
+}
+
+void* Arena::allocateSlow(std::size_t size, std::size_t align)
+{
+    // Chunks are max_align_t aligned, so this is enough room for any padding
+    const std::size_t needed = size + align;
+    const std::size_t chunkSize = std::max(m_chunkSize, needed);
+
+    Chunk* chunk = static_cast<Chunk*>(::operator new(sizeof(Chunk) + chunkSize));
+    chunk->size = chunkSize;
+
+    if (m_chunks && chunkSize > m_chunkSize && m_pos != m_end)
+    {
+        // Oversized request, keep bumping in the current chunk afterwards
+        chunk->next = m_chunks->next;
+        m_chunks->next = chunk;
+
+        const uintptr_t pos = (reinterpret_cast<uintptr_t>(chunk->begin()) + align - 1) & ~(uintptr_t(align) - 1);
+        m_allocated += size;
+        return reinterpret_cast<void*>(pos);
+    }
+
+    chunk->next = m_chunks;
+    m_chunks = chunk;
+    m_pos = chunk->begin();
+    m_end = chunk->end();
+
+    return allocate(size, align);
+}
+
+void Arena::reset()
+{
+    if (!m_chunks)
+        return;
+
+    if (m_chunks->next)
+    {
+        // Everything didn't fit in one chunk, replace them all by one that would have
+        std::size_t total = 0;
+        for (Chunk* chunk = m_chunks; chunk; chunk = chunk->next)
+            total += chunk->size;
+
+        freeChunks(m_chunks);
+        m_chunkSize = std::max(m_chunkSize, total);
+
+        m_chunks = static_cast<Chunk*>(::operator new(sizeof(Chunk) + m_chunkSize));
+        m_chunks->next = nullptr;
+        m_chunks->size = m_chunkSize;
+    }
+
+    m_pos = m_chunks->begin();
+    m_end = m_chunks->end();
+    m_allocated = 0;
+}
+
+} // bitforge
@@ -0,0 +1,140 @@
+/*
+ * arena.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: gianni
+ *
+ * BitForge http://www.bitforge.com.br
+ * Copyright (c) 2012 All Right Reserved,
+ */
+
+#ifndef __INCLUDE_LIBBF_ARENA_H_
+#define __INCLUDE_LIBBF_ARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include <bf/ncstring.h>
+
+namespace bitforge
+{
+
+/**
+ * @class Arena
+ * @description Bump allocator for per-request or per-batch data. Memory is taken from
+ * chunks and only given back all at once by reset() or the destructor. reset() keeps a
+ * single chunk, grown to fit everything the last round needed, so a request loop settles
+ * on no allocations at all.
+ * An arena is meant to be used by one thread at a time.
+ */
+class Arena
+{
+private:
+    struct Chunk
+    {
+        Chunk*      next;
+        std::size_t size;
+
+        char* begin() { return reinterpret_cast<char*>(this + 1); }
+        char* end() { return begin() + size; }
+    };
+
+    Chunk*      m_chunks = nullptr;     // Most recent first
+    char*       m_pos = nullptr;
+    char*       m_end = nullptr;
+    std::size_t m_chunkSize;
+    std::size_t m_allocated = 0;        // Bytes handed out since the last reset
+
+    static thread_local Arena* s_current;
+
+    void* allocateSlow(std::size_t size, std::size_t align);
+    void freeChunks(Chunk* chunk);
+
+public:
+    explicit Arena(std::size_t chunkSize = 64 * 1024);
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    void operator=(const Arena&) = delete;
+
+    void* allocate(std::size_t size, std::size_t align = alignof(std::max_align_t))
+    {
+        const uintptr_t pos = (reinterpret_cast<uintptr_t>(m_pos) + align - 1) & ~(uintptr_t(align) - 1);
+        if (m_pos && pos + size <= reinterpret_cast<uintptr_t>(m_end))
+        {
+            m_pos = reinterpret_cast<char*>(pos + size);
+            m_allocated += size;
+            return reinterpret_cast<void*>(pos);
+        }
+
+        return allocateSlow(size, align);
+    }
+
+    // Invalidates everything allocated from the arena
+    void reset();
+
+    std::size_t allocated() const { return m_allocated; }
+
+    // The arena installed by the innermost Scope on this thread, if any
+    static Arena* current() { return s_current; }
+
+    /**
+     * Makes @arena the current one for this thread until the scope ends, e.g. around the
+     * handling of a request.
+     */
+    class Scope
+    {
+    private:
+        Arena* m_previous;
+
+    public:
+        explicit Scope(Arena& arena): m_previous(s_current) { s_current = &arena; }
+        ~Scope() { s_current = m_previous; }
+
+        Scope(const Scope&) = delete;
+        void operator=(const Scope&) = delete;
+    };
+};
+
+/**
+ * SharedMemoryBlock storage taken from the current Arena (see Arena::Scope), or from the heap
+ * when there is none. Releasing an arena block is free.
+ */
+class ArenaBlockStorage
+{
+private:
+    const bool m_heap;      // Not from an arena, deleted with the last reference
+
+protected:
+    // Runs right after allocate(), on the same thread, so it sees the same current arena
+    ArenaBlockStorage(): m_heap(Arena::current() == nullptr) {}
+
+    static void* allocate(std::size_t size, std::size_t align)
+    {
+        if (Arena* arena = Arena::current())
+            return arena->allocate(size, align);
+
+        return ::operator new(size);
+    }
+
+    static void deallocate(void* memory) { ::operator delete(memory); }
+    bool freeOnRelease() const { return m_heap; }
+
+public:
+    bool fromArena() const { return !m_heap; }
+};
+
+/**
+ * Memory object for thread-confined strings: a plain reference count, so copies and moves are
+ * as cheap as LocalNCString's, with the memory taken from the current arena.
+ * Strings using it must stay on the arena's thread and not outlive its reset().
+ */
+typedef SharedMemoryBlock<NonAtomicRefCount, ArenaBlockStorage> ArenaMemoryBlock;
+
+// Thread-confined string allocated from the current Arena
+typedef BasicNCString<ArenaMemoryBlock> ArenaNCString;
+
+} // bitforge
+
+#endif // __INCLUDE_LIBBF_ARENA_H_
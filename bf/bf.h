@@ -13,13 +13,23 @@
 
 #define UNUSED(ARG) do { (void(ARG)) } while (false)
 
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include <ctime>
 #include <cmath>
 #include <cassert>
 #include <unistd.h>
 
+#include <bf/checksum.h>
+#include <bf/floatfmt.h>
+#include <bf/inthex.h>
 #include <bf/ncstring.h>
+#include <bf/strutils.h>
+#include <bf/process.h>
+#include <bf/timer.h>
+#include <bf/timestamp.h>
+#include <bf/topology.h>
 
 namespace bitforge
 {
@@ -87,33 +97,46 @@ public:
     bool operator<(const SingletonStrongTypedef<T>& other) const { return m_value <  other.m_value; }
 };
     
+/**
+ * Equality of any mix of NCStrings, std::strings, C strings and StringViews. Nothing is
+ * copied: both sides are looked at as views and the lengths are compared first.
+ */
 template <typename R, typename L>
 class StringsComparer
 {
 private:
-    static const char* get_char_str(NCString s) { return s.c_str(); }
-    static const char* get_char_str(::std::string s) { return s.c_str(); }
-    static const char* get_char_str(const char *s) { return s; }
+    static StringView view(const char* s) { return StringView(s, strlen(s)); }
+    static StringView view(const std::string& s) { return StringView(s.data(), s.size()); }
+    static StringView view(StringView s) { return s; }
+
+    template<typename T>
+    static StringView view(const BasicNCString<T>& s) { return s.view(); }
+
 public:
-    static bool IsEqual(L str1, R str2)
+    static bool IsEqual(const L& str1, const R& str2)
     {
-        return strcmp(get_char_str(str1), get_char_str(str2)) == 0;
+        const StringView v1 = view(str1);
+        const StringView v2 = view(str2);
+        return v1.size() == v2.size() && memcmp(v1.data(), v2.data(), v1.size()) == 0;
     }
 
-    static bool IsEqualICase(L str1, R str2)
+    // Ignores ASCII case only, like strcasecmp in the C locale
+    static bool IsEqualICase(const L& str1, const R& str2)
     {
-        return strcasecmp(get_char_str(str1), get_char_str(str2)) == 0;
+        const StringView v1 = view(str1);
+        const StringView v2 = view(str2);
+        return v1.size() == v2.size() && asciiCaseEqual(v1.data(), v2.data(), v1.size());
     }
 };
 
 template<typename L, typename R>
-bool CompStr(L str1, R str2)
+bool CompStr(const L& str1, const R& str2)
 {
     return StringsComparer<R, L>::IsEqual(str1, str2);
 }
 
 template<typename L, typename R>
-bool ICompStr(L str1, R str2)
+bool ICompStr(const L& str1, const R& str2)
 {
     return StringsComparer<R, L>::IsEqualICase(str1, str2);
 }
@@ -130,7 +153,7 @@ private:
 public:
     virtual const char* what() const throw()
     {
-        return m_what.data();
+        return m_what.c_str();
     };
 };
 
@@ -152,33 +175,56 @@ enum DateFormat
     dfCompact
 };
 
+// Writes @tm as YYYY-MM-DD HH:MM:SS with the given separators, 0 ones are left out. Returns the end
+inline char* formatDateTime(char* buffer, const struct tm& tm, char dateSeparator, char separator, char timeSeparator)
+{
+    char* c = formatFixed<4>(buffer, tm.tm_year + 1900);
+    if (dateSeparator)
+        *c++ = dateSeparator;
+    c = formatFixed<2>(c, tm.tm_mon + 1);
+    if (dateSeparator)
+        *c++ = dateSeparator;
+    c = formatFixed<2>(c, tm.tm_mday);
+
+    if (separator)
+        *c++ = separator;
+
+    c = formatFixed<2>(c, tm.tm_hour);
+    if (timeSeparator)
+        *c++ = timeSeparator;
+    c = formatFixed<2>(c, tm.tm_min);
+    if (timeSeparator)
+        *c++ = timeSeparator;
+    return formatFixed<2>(c, tm.tm_sec);
+}
+
+// Current UTC date, formatted once per second and shared by all threads
 inline std::string getDate(DateFormat dateFormat = dfSQL)
 {
     char dateStr[32];
-
-    time_t t;
-    struct tm tm;
-
-    ::std::time(&t);
-    gmtime_r(&t, &tm);
-
-    const char* format;
+    char* c = dateStr;
 
     switch(dateFormat)
     {
         case dfSQL:
-            format = "'%.4d-%.2d-%.2d %.2d:%.2d:%.2d'";
+        {
+            static TimestampCache s_sqlDate(TimestampCache::tzUTC, '-', ' ', ':');
+            *c++ = '\'';
+            c = s_sqlDate.format(c);
+            *c++ = '\'';
             break;
+        }
 
         case dfCompact:
         default:
-            format = "%.4d%.2d%.2d%.2d%.2d%.2d";
+        {
+            static TimestampCache s_compactDate(TimestampCache::tzUTC, 0, 0, 0);
+            c = s_compactDate.format(c);
             break;
+        }
     }
 
-    ::std::snprintf(dateStr, sizeof(dateStr), format, tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec);
-
-    return dateStr;
+    return std::string(dateStr, c - dateStr);
 }
 
 inline timespec timespecDiff(timespec start, timespec end)
@@ -197,42 +243,30 @@ inline timespec timespecDiff(timespec start, timespec end)
     return temp;
 }
 
+// Monotonic time stamp, subtract two for the elapsed time
 class ProcTimer
 {
 private:
-    struct timespec m_time;
+    int64_t m_nanoseconds;
 
-    ProcTimer(struct timespec ts) : m_time(ts) {}
+    explicit ProcTimer(int64_t nanoseconds) : m_nanoseconds(nanoseconds) {}
 
 public:
-    ProcTimer()
-    {
-        clock_gettime(CLOCK_REALTIME, &m_time);
-    }
+    ProcTimer() : m_nanoseconds(MonotonicClock::now()) {}
 
     ProcTimer operator- (const ProcTimer& other) const
     {
-        struct timespec ts = other.m_time;
-
-        if(m_time.tv_nsec > ts.tv_nsec)
-        {
-            ts.tv_nsec = m_time.tv_nsec - ts.tv_nsec;
-        }
-        else
-        {
-            auto d = ts.tv_nsec - m_time.tv_nsec;
-            ts.tv_sec--;
-            ts.tv_nsec = pow10(9) - d;
-        }
-
-        ts.tv_sec = m_time.tv_sec - ts.tv_sec;
+        return ProcTimer(m_nanoseconds - other.m_nanoseconds);
+    }
 
-        return ProcTimer(ts);
+    int64_t nanoseconds() const
+    {
+        return m_nanoseconds;
     }
 
     double seconds() const
     {
-        return static_cast<double>(m_time.tv_sec) + (static_cast<double>(m_time.tv_nsec) / pow10(9));
+        return static_cast<double>(m_nanoseconds / 1000000000) + static_cast<double>(m_nanoseconds % 1000000000) / 1e9;
     }
 
     double operator/ (double value) const
@@ -242,13 +276,14 @@ public:
 
     bool operator> (int value) const
     {
-        return seconds() > value;
+        return m_nanoseconds > static_cast<int64_t>(value) * 1000000000;
     }
 };
 
 inline std::ostream& operator<< (std::ostream& out, const ProcTimer& timer)
 {
-    out << round(timer.seconds() * 100) / 100;
+    char buffer[DoubleBufferSize];
+    out.write(buffer, dtoaFixed(buffer, timer.seconds(), 2));
     return out;
 }
 
@@ -285,34 +320,10 @@ bool is_zero(const T& t)
     return true;
 }
 
-inline std::string stringStrip(std::string str)
+inline std::string stringStrip(StringView str)
 {
-    if (!str.empty())
-    {
-        for(int i = 0, end = str.size(); i < end; i++)
-        {
-            if(!isspace(str[i]))
-            {
-                str.erase(0, i);
-                goto FOUND_PRINTABLE;
-            }
-        }
-
-        str.clear();
-        return str;
-        
-FOUND_PRINTABLE:
-        for(int i = str.size() - 1, end = 0; i > end; i--)
-        {
-            if(!isspace(str[i]))
-            {
-                str.erase(i + 1, str.size());
-                break;
-            }
-        }
-    }
-    
-    return str;
+    const StringView stripped = strip(str);
+    return std::string(stripped.data(), stripped.size());
 }
 
 
@@ -354,7 +365,215 @@ constexpr unsigned int operator "" _key(const char* str, std::size_t len)
                    (str[0] << 24) + (str[1] << 16) + (str[2] << 8) + (str[3]);
 }
 
-// Get the number of cores reported by the OS.
+constexpr char asciiLower(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? c | 0x20 : c;
+}
+
+/*
+ * 64 bit FNV-1a of a string, usable at compile time; strHash(str, len) == stringHash(str, len).
+ * Unlike strKey() every char counts, so string keyed dispatch can switch on the hash:
+ *
+ *   switch (stringHash(cmd.data(), cmd.size()))
+ *   {
+ *       case "reload"_hash: if (cmd == "reload") ...
+ *
+ * striHash() hashes the ASCII lower case, stringHashLower() is its runtime loop.
+ * Equal hashes don't mean equal strings, always compare after matching one (KeywordSet does).
+ */
+
+constexpr uint64_t strHash(const char* str, std::size_t length, uint64_t hash = FnvOffsetBasis)
+{
+    return length == 0 ? hash :
+        strHash(str + 1, length - 1, (hash ^ static_cast<unsigned char>(str[0])) * FnvPrime);
+}
+
+constexpr uint64_t striHash(const char* str, std::size_t length, uint64_t hash = FnvOffsetBasis)
+{
+    return length == 0 ? hash :
+        striHash(str + 1, length - 1, (hash ^ static_cast<unsigned char>(asciiLower(str[0]))) * FnvPrime);
+}
+
+constexpr uint64_t operator "" _hash(const char* str, std::size_t len)
+{
+    return strHash(str, len);
+}
+
+inline uint64_t stringHashLower(const char* data, std::size_t length)
+{
+    uint64_t hash = FnvOffsetBasis;
+
+    for (std::size_t i = 0; i < length; i++)
+    {
+        hash ^= static_cast<unsigned char>(asciiLower(data[i]));
+        hash *= FnvPrime;
+    }
+
+    return hash;
+}
+
+// A keyword of a KeywordSet, hashed at compile time
+struct Keyword
+{
+    const char*     str;
+    std::size_t     length;
+    uint64_t        hash;
+    uint64_t        lowerHash;
+
+    template<std::size_t N>
+    constexpr Keyword(const char (&keyword)[N]):
+        str(keyword), length(N - 1), hash(strHash(keyword, N - 1)), lowerHash(striHash(keyword, N - 1)) {}
+};
+
+// Bits needed for @n different values, at least @bits
+constexpr std::size_t bitsFor(std::size_t n, std::size_t bits = 1)
+{
+    return (std::size_t(1) << bits) >= n ? bits : bitsFor(n, bits + 1);
+}
+
+template<std::size_t... I>
+struct IndexSequence {};
+
+template<std::size_t N, std::size_t... I>
+struct MakeIndexSequence: MakeIndexSequence<N - 1, N - 1, I...> {};
+
+template<std::size_t... I>
+struct MakeIndexSequence<0, I...>: IndexSequence<I...> {};
+
+/**
+ * @class KeywordSet
+ * @description Fixed set of ASCII keywords with a perfect hash table built at compile time.
+ * match() is one hash of the input, one table lookup and one compare against the only
+ * keyword it can be. Case is ignored unless @CaseSensitive.
+ *
+ *   static constexpr KeywordSet<2> s_schemes = { "http", "https" };
+ *   switch (s_schemes.match(str.data(), str.length())) ...
+ */
+template<std::size_t N, bool CaseSensitive = false>
+class KeywordSet
+{
+private:
+    // At least 4 slots per keyword, so a collision free multiplier turns up quickly
+    static constexpr std::size_t TableBits = bitsFor(4 * N);
+    static constexpr std::size_t TableSize = std::size_t(1) << TableBits;
+    static constexpr uint64_t FirstMultiplier = 0x9e3779b97f4a7c15ull;
+    static constexpr unsigned MaxMultipliers = 1024;
+
+    static constexpr uint64_t keyHash(const Keyword& keyword)
+    {
+        return CaseSensitive ? keyword.hash : keyword.lowerHash;
+    }
+
+    static constexpr std::size_t slot(uint64_t hash, uint64_t multiplier)
+    {
+        return static_cast<std::size_t>((hash * multiplier) >> (64 - TableBits));
+    }
+
+    static constexpr bool noneInSlot(std::size_t, uint64_t)
+    {
+        return true;
+    }
+
+    template<typename... K>
+    static constexpr bool noneInSlot(std::size_t s, uint64_t multiplier, const Keyword& keyword, const K&... rest)
+    {
+        return slot(keyHash(keyword), multiplier) != s && noneInSlot(s, multiplier, rest...);
+    }
+
+    static constexpr bool collisionFree(uint64_t)
+    {
+        return true;
+    }
+
+    template<typename... K>
+    static constexpr bool collisionFree(uint64_t multiplier, const Keyword& keyword, const K&... rest)
+    {
+        return noneInSlot(slot(keyHash(keyword), multiplier), multiplier, rest...) && collisionFree(multiplier, rest...);
+    }
+
+    template<typename... K>
+    static constexpr uint64_t tryMultiplier(uint64_t multiplier, const K&... keywords)
+    {
+        return collisionFree(multiplier, keywords...) ? multiplier : 0;
+    }
+
+    template<typename... K>
+    static constexpr uint64_t firstOf(uint64_t found, unsigned first, unsigned count, const K&... keywords)
+    {
+        return found ? found : searchMultipliers(first, count, keywords...);
+    }
+
+    // First collision free multiplier of @count attempts from @first, 0 if none. The attempts
+    // are split in halves so the recursion stays well within the constexpr depth limit
+    template<typename... K>
+    static constexpr uint64_t searchMultipliers(unsigned first, unsigned count, const K&... keywords)
+    {
+        return count == 1 ? tryMultiplier(FirstMultiplier + 2 * first, keywords...) :
+            firstOf(searchMultipliers(first, count / 2, keywords...), first + count / 2, count - count / 2, keywords...);
+    }
+
+    static constexpr uint64_t checkMultiplier(uint64_t multiplier)
+    {
+        return multiplier ? multiplier : throw "KeywordSet: no perfect hash, duplicate keywords?";
+    }
+
+    template<typename... K>
+    static constexpr uint64_t findMultiplier(const K&... keywords)
+    {
+        return checkMultiplier(searchMultipliers(0, MaxMultipliers, keywords...));
+    }
+
+    // Index of the keyword in slot @s, -1 if none
+    static constexpr int8_t keywordInSlot(std::size_t, uint64_t, int)
+    {
+        return -1;
+    }
+
+    template<typename... K>
+    static constexpr int8_t keywordInSlot(std::size_t s, uint64_t multiplier, int index, const Keyword& keyword, const K&... rest)
+    {
+        return slot(keyHash(keyword), multiplier) == s ? index : keywordInSlot(s, multiplier, index + 1, rest...);
+    }
+
+    const Keyword   m_keywords[N];
+    const uint64_t  m_multiplier;
+    const int8_t    m_slots[TableSize];
+
+    template<std::size_t... S, typename... K>
+    constexpr KeywordSet(IndexSequence<S...>, uint64_t multiplier, const K&... keywords):
+        m_keywords{ keywords... }, m_multiplier(multiplier), m_slots{ keywordInSlot(S, multiplier, 0, keywords...)... } {}
+
+public:
+    template<std::size_t... L>
+    constexpr KeywordSet(const char (&... keywords)[L]):
+        KeywordSet(MakeIndexSequence<TableSize>(), findMultiplier(Keyword(keywords)...), Keyword(keywords)...)
+    {
+        static_assert(sizeof...(L) == N, "KeywordSet size mismatch");
+        static_assert(N < 128, "KeywordSet indexes must fit an int8_t");
+    }
+
+    // Index of the keyword equal to @str, -1 if none
+    int match(const char* str, std::size_t length) const
+    {
+        const uint64_t hash = CaseSensitive ? stringHash(str, length) : stringHashLower(str, length);
+        const int index = m_slots[slot(hash, m_multiplier)];
+        if (index < 0)
+            return -1;
+
+        const Keyword& keyword = m_keywords[index];
+        if (keyword.length != length || keyHash(keyword) != hash)
+            return -1;
+
+        const bool equal = CaseSensitive ? memcmp(str, keyword.str, length) == 0 : asciiCaseEqual(str, keyword.str, length);
+        return equal ? index : -1;
+    }
+
+    int match(StringView str) const { return match(str.data(), str.size()); }
+
+    static constexpr std::size_t size() { return N; }
+};
+
+// Get the number of online logical CPUs reported by the OS, see CpuTopology for the details.
 int getNumCores();
 
 
@@ -378,8 +597,9 @@ struct ProcStreams
 *	Start a process, but connect the process' stdin, stdout and strerr to pipes which are then
 *  returned to the caller in the @streams param.
 *  @param streams out structre to recieve the pipes for the process's streams.
-*  @param args process name and arguments.  args[0] should be the exec name (i.e. /bin/ls)
+*  @param args process name and arguments, ending with a nullptr.  args[0] should be the exec name (i.e. /bin/ls)
 *  @param env enviroment for the new process.  The default is a copy of the current process' enviroment.
+*  The process is started with spawnProcess and is not reaped; Process does both and collects the output.
 */
 bool runAttachedProcess(ProcStreams* streams, const char* const args[], const char* const env[] = environ);
 
@@ -388,9 +608,6 @@ bool runAttachedProcess(ProcStreams* streams, const char* const args[], const ch
  */
 std::size_t getSystemPageSize();
 
-/* Fast hash function */
-uint32_t fletcher32(const char* data, ::std::size_t len);
-
 }
 
 #endif // __INCLUDE_LIBBF_BF_H_
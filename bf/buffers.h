@@ -11,10 +11,18 @@
 #ifndef __INCLUDE_LIBBF_BUFFERS_H_
 #define __INCLUDE_LIBBF_BUFFERS_H_
 
+#include <deque>
 #include <memory>
 #include <stack>
+#include <string>
 #include <vector>
 
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+
 #include <bf/bf.h>
 
 namespace bitforge {
@@ -178,6 +186,18 @@ public:
         
         return size;
     }
+    
+    // Calls @function(data, size) for the readable data, in at most two contiguous pieces
+    template<typename Function>
+    void forEachSegment(Function function) const
+    {
+        const size_t first = std::min(static_cast<size_t>(m_bufferEnd - m_posRead), m_availRead);
+        
+        if (first)
+            function(static_cast<const T*>(m_posRead), first * sizeof(T));
+        if (m_availRead > first)
+            function(static_cast<const T*>(m_buffer), (m_availRead - first) * sizeof(T));
+    }
 };
 
 class MemoryPool
@@ -188,6 +208,15 @@ public:
     MemoryPool(size_type minNumberPageCahce = 1, size_type pageSize = getSystemPageSize()): 
     m_minNumberPageCahce(minNumberPageCahce), m_pageSize(pageSize) {};
     
+    ~MemoryPool()
+    {
+        while(!m_pageStack.empty())
+        {
+            free(m_pageStack.top());
+            m_pageStack.pop();
+        }
+    }
+    
     class MemoryPage
     {
     private:
@@ -238,6 +267,9 @@ public:
     typedef std::unique_ptr<MemoryPool::MemoryPage> MemoryPagePtr;
     inline MemoryPagePtr getPage();
     size_type  pageSize() const { return m_pageSize; }
+    
+    // True when pages cover whole system pages, required for vmsplice/madvise
+    bool isPageAligned() const { return m_pageSize && (m_pageSize % sysconf(_SC_PAGESIZE)) == 0; }
 };
 typedef std::shared_ptr<MemoryPool> MemoryPoolPtr;
 
@@ -246,10 +278,7 @@ void MemoryPool::returnPage(MemoryPool::MemoryPage* page)
     if (m_pageStack.size() < m_minNumberPageCahce)
         m_pageStack.push(page->data());
     else
-    {
-        char* ptr = static_cast<char*>(page->data());
-        delete[] ptr;
-    }
+        free(page->data());
 }
 
 MemoryPool::MemoryPagePtr MemoryPool::getPage()
@@ -261,18 +290,184 @@ MemoryPool::MemoryPagePtr MemoryPool::getPage()
         m_pageStack.pop();
     }
     else
-        ptr = new char[m_pageSize];
+    {
+        // Pages are aligned to the system page so they can be mapped/spliced by the kernel
+        if (posix_memalign(&ptr, sysconf(_SC_PAGESIZE), m_pageSize) != 0)
+            throw std::bad_alloc();
+    }
     
     return MemoryPagePtr(new MemoryPage(this, ptr));
 }
 
 
+/**
+ * Anonymous file that holds pages evicted from memory by a SimpleBuffer.
+ * It is created with O_TMPFILE so it never has a name and is released by the
+ * kernel as soon as the descriptor (and any mapping of it) is closed.
+ */
+class SpillFile
+{
+public:
+    typedef std::size_t size_type;
+
+    SpillFile(const char* directory, size_type pageSize)
+    {
+        const size_type systemPageSize = sysconf(_SC_PAGESIZE);
+        m_slotSize = ((pageSize + systemPageSize - 1) / systemPageSize) * systemPageSize;
+        
+        m_fd = open(directory, O_TMPFILE | O_RDWR | O_EXCL | O_CLOEXEC, S_IRUSR | S_IWUSR);
+        
+        if (m_fd == -1 && (errno == EOPNOTSUPP || errno == EISDIR || errno == EINVAL))
+        {
+            // Filesystem (or kernel) without O_TMPFILE support, emulate it
+            std::string path = std::string(directory) + "/libbf-spill-XXXXXX";
+            m_fd = mkostemp(&path[0], O_CLOEXEC);
+            if (m_fd != -1)
+                unlink(path.c_str());
+        }
+        
+        if (m_fd == -1)
+            throw ErrnoException(std::string("Unable to create spill file in ") + directory, errno);
+    }
+    
+    ~SpillFile()
+    {
+        close(m_fd);
+    }
+    
+    SpillFile(const SpillFile&) = delete;
+    void operator=(const SpillFile&) = delete;
+    
+    int fd() const { return m_fd; }
+    
+    // Size of a page slot in the file, always a multiple of the system page size so slots can be mmap'ed
+    size_type slotSize() const { return m_slotSize; }
+    
+    off_t store(const void* data, size_type size)
+    {
+        assert(size <= m_slotSize);
+        
+        off_t offset;
+        if (!m_freeSlots.empty())
+        {
+            offset = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        }
+        else
+        {
+            offset = m_fileSize;
+            m_fileSize += m_slotSize;
+            
+            if (ftruncate(m_fd, m_fileSize) == -1)
+                throw ErrnoException("Unable to grow spill file", errno);
+        }
+        
+        const char* ptr = static_cast<const char*>(data);
+        size_type done = 0;
+        while(done < size)
+        {
+            ssize_t res = pwrite(m_fd, ptr + done, size - done, offset + done);
+            if (res == -1)
+            {
+                if (errno == EINTR)
+                    continue;
+                throw ErrnoException("Unable to write to spill file", errno);
+            }
+            done += res;
+        }
+        
+        return offset;
+    }
+    
+    size_type load(void* data, size_type size, off_t offset) const
+    {
+        char* ptr = static_cast<char*>(data);
+        size_type done = 0;
+        while(done < size)
+        {
+            ssize_t res = pread(m_fd, ptr + done, size - done, offset + done);
+            if (res == -1)
+            {
+                if (errno == EINTR)
+                    continue;
+                throw ErrnoException("Unable to read from spill file", errno);
+            }
+            if (res == 0)
+                break;
+            done += res;
+        }
+        
+        return done;
+    }
+    
+    /**
+     * Gives a slot back for reuse. It is punched out first, which detaches its page cache pages
+     * from the file: a socket still sending them keeps them, and the next store() gets new ones.
+     * Where punching holes isn't supported the slot just stays unused.
+     * Pages spliced into a pipe must have left it before, the pipe would drop a detached page.
+     */
+    void release(off_t offset)
+    {
+        if (fallocate(m_fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, offset, m_slotSize) == 0)
+            m_freeSlots.push_back(offset);
+    }
+    
+    // Bytes of file covered by slots, used or free
+    off_t fileSize() const { return m_fileSize; }
+    
+    class Mapping
+    {
+    private:
+        void*       m_addr;
+        size_type   m_size;
+        
+    public:
+        Mapping(const SpillFile& file, off_t offset): m_size(file.slotSize())
+        {
+            m_addr = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, file.fd(), offset);
+            if (m_addr == MAP_FAILED)
+                throw ErrnoException("Unable to map spilled page", errno);
+        }
+        
+        ~Mapping()
+        {
+            munmap(m_addr, m_size);
+        }
+        
+        Mapping(const Mapping&) = delete;
+        void operator=(const Mapping&) = delete;
+        
+        void* data() const { return m_addr; }
+    };
+    typedef std::shared_ptr<Mapping> MappingPtr;
+    
+private:
+    int         m_fd = -1;
+    size_type   m_slotSize;
+    off_t       m_fileSize = 0;
+    
+    std::vector<off_t> m_freeSlots;
+};
+typedef std::unique_ptr<SpillFile> SpillFilePtr;
+
 template<typename T>
 class SimpleBuffer
 {
 public:
     typedef std::size_t size_type;
-    typedef std::vector<std::pair<MemoryPool::MemoryPagePtr, size_type>> MemoryVector;
+    
+    struct Page
+    {
+        MemoryPool::MemoryPagePtr   memory;         // Null while the page lives in the spill file
+        size_type                   size;
+        off_t                       spillOffset;
+        
+        Page(MemoryPool::MemoryPagePtr&& _memory, size_type _size):
+        memory(std::move(_memory)), size(_size), spillOffset(-1) {}
+        
+        bool isSpilled() const { return !memory; }
+    };
+    typedef std::deque<Page> MemoryVector;
     
     SimpleBuffer(MemoryPoolPtr __pool = std::make_shared<MemoryPool>()) : m_pool(__pool) {}
     SimpleBuffer(T *v, size_type n, MemoryPoolPtr __pool = std::make_shared<MemoryPool>()) : m_pool(__pool) { write(v, n); }
@@ -281,36 +476,54 @@ public:
     {
     protected:
         SimpleBuffer<T> *m_parent;
-        MemoryVector::iterator m_it;
+        typename MemoryVector::iterator m_it;
+        SpillFile::MappingPtr m_mapping;
         
-    public:
-        Iterator(SimpleBuffer<T> *parent, MemoryVector::iterator it): 
-        m_parent(parent), m_it(it)
+        void load()
         {
             if (m_it != m_parent->m_data.end())
             {
-                data = static_cast<T*>(it->first->data());
-                size = it->second;
+                if (m_it->isSpilled())
+                {
+                    m_mapping = std::make_shared<SpillFile::Mapping>(*m_parent->m_spillFile, m_it->spillOffset);
+                    data = static_cast<T*>(m_mapping->data());
+                }
+                else
+                {
+                    m_mapping.reset();
+                    data = static_cast<T*>(m_it->memory->data());
+                }
+                size = m_it->size;
+                
+                // Skip what was already handed to the kernel by spliceTo()
+                if (m_it == m_parent->m_data.begin())
+                {
+                    data += m_parent->m_headOffset;
+                    size -= m_parent->m_headOffset;
+                }
+            }
+            else
+            {
+                m_mapping.reset();
+                data = nullptr;
+                size = 0;
             }
         }
         
+    public:
+        Iterator(SimpleBuffer<T> *parent, typename MemoryVector::iterator it): 
+        m_parent(parent), m_it(it)
+        {
+            load();
+        }
+        
         T* data = nullptr;
         size_type size = 0;
         
         Iterator& operator++(int)  
         { 
             ++m_it;
-            
-            if (m_it != m_parent->m_data.end())   
-            {
-                data = static_cast<T*>(m_it->first->data());
-                size = m_it->second;
-            }
-            else
-            {
-                data = nullptr;
-                size = 0;
-            }
+            load();
             return *this;
         }
         
@@ -327,19 +540,122 @@ private:
     size_type m_size = 0;
     size_type m_availWrite = 0;
     
+    // Spill-to-disk state; spilled pages always form a prefix of m_data
+    SpillFilePtr m_spillFile;
+    size_type m_spillThreshold = 0;
+    size_type m_spilledPages = 0;
+    std::string m_spillDirectory;
+    
+    // Zero-copy egress state, see spliceTo()
+    int m_pipe[2] = { -1, -1 };
+    size_type m_pipeBytes = 0;
+    size_type m_headOffset = 0;
+    std::vector<off_t> m_pipedSlots;    // Spill slots with data in the pipe, released once it is empty
+    
     void getNewPage()
     {
         MemoryPool* pool = m_pool.get();
         MemoryPool::MemoryPagePtr page = pool->getPage();
         m_writePos = static_cast<T*>(page->data());
-        m_data.push_back(std::make_pair(std::move(page), 0));
+        m_data.push_back(Page(std::move(page), 0));
         m_availWrite += pool->pageSize();
+        
+        if (m_spillThreshold)
+            spillColdPages();
+    }
+    
+    void spillColdPages()
+    {
+        // The page being written to is never spilled
+        while(m_spilledPages + 1 < m_data.size() && residentSize() > m_spillThreshold)
+        {
+            // A page partially handed to the kernel by spliceTo() must stay where it is
+            if (m_spilledPages == 0 && m_headOffset)
+                break;
+            
+            if (!m_spillFile)
+                m_spillFile = SpillFilePtr(new SpillFile(m_spillDirectory.c_str(), m_pool->pageSize()));
+            
+            Page& page = m_data[m_spilledPages];
+            page.spillOffset = m_spillFile->store(page.memory->data(), page.size);
+            page.memory.reset();
+            m_spilledPages++;
+        }
+    }
+    
+    void retireHeadPage()
+    {
+        Page& page = m_data.front();
+        
+        if (page.isSpilled())
+            m_spilledPages--;
+        
+        if (m_data.size() == 1)
+        {
+            // The write page was consumed, new data must go to a fresh page
+            m_writePos = nullptr;
+            m_availWrite = 0;
+        }
+        
+        releasePage(page);
+        m_data.pop_front();
+        m_headOffset = 0;
+    }
+    
+    // Releases a page whose contents were handed to the kernel. The pipe, the socket or a local
+    // peer's receive queue (even after the data was acknowledged) may still reference its memory,
+    // so it must never be written over in place.
+    void releasePage(Page& page)
+    {
+        if (!page.isSpilled())
+        {
+            // Drop our mapping of the memory. Pages the kernel still references stay alive
+            // until it is done with them and the pool gets fresh zero pages on next touch.
+            madvise(page.memory->data(), m_pool->pageSize(), MADV_DONTNEED);
+        }
+        else
+            m_pipedSlots.push_back(page.spillOffset);
+        
+        page.memory.reset();
     }
     
 public:
+    ~SimpleBuffer()
+    {
+        if (m_pipe[0] != -1)
+        {
+            close(m_pipe[0]);
+            close(m_pipe[1]);
+        }
+    }
+    
+    // Bytes still to be sent; spliceTo() stops counting them once they are in its pipe, even
+    // before the socket took them
     size_type size() const { return m_size; }
     size_type pageSize() const { return m_pool->pageSize(); }
     
+    // Bytes of page memory currently held in RAM
+    size_type residentSize() const { return (m_data.size() - m_spilledPages) * m_pool->pageSize(); }
+    size_type spilledPages() const { return m_spilledPages; }
+    
+    // Size of the spill file, 0 if nothing was ever spilled
+    off_t spillFileSize() const { return m_spillFile ? m_spillFile->fileSize() : 0; }
+    
+    /**
+     * Enable spill-to-disk mode.
+     * Once more than @threshold bytes of pages are resident, the oldest pages are moved to an
+     * anonymous O_TMPFILE file created in @directory and mapped back in when iterated.
+     * The file is gone once the buffer is destroyed. A @threshold of 0 disables spilling.
+     */
+    void setSpillThreshold(size_type threshold, const char* directory = "/tmp")
+    {
+        m_spillThreshold = threshold;
+        m_spillDirectory = directory;
+        
+        if (m_spillThreshold)
+            spillColdPages();
+    }
+    
     void append(T *v, size_type n)
     {
         while(n)
@@ -355,7 +671,7 @@ public:
             n -= sz;
             m_size += sz;
             m_availWrite -= sz;
-            m_data.rbegin()->second += sz;
+            m_data.rbegin()->size += sz;
         }
     }
     
@@ -366,10 +682,13 @@ public:
         auto it = m_data.begin();
         while(n && it != m_data.end())
         {
-            char *ptr = static_cast<T*>(it->first->data());
-            const size_type sz = std::min(it->second, n);
+            const size_type offset = (it == m_data.begin()) ? m_headOffset : 0;
+            const size_type sz = std::min(it->size - offset, n);
             
-            memcpy(v, ptr, sz);
+            if (it->isSpilled())
+                m_spillFile->load(v, sz, it->spillOffset + offset);
+            else
+                memcpy(v, static_cast<T*>(it->memory->data()) + offset, sz);
             
             v += sz;
             n -= sz;
@@ -380,6 +699,115 @@ public:
         return result;
     }
     
+    /**
+     * Send the buffer contents to a (TCP) socket without copying it through user space.
+     * Resident pages are mapped into a pipe with vmsplice(), spilled pages are spliced from the
+     * spill file, and the pipe is then spliced to the socket with @socket.spliceWrite().
+     * Data is removed from the buffer (and from size()) as soon as it is in the pipe, which may be
+     * before the socket takes it. For non-blocking sockets this may send less than was piped; the
+     * rest stays in the pipe and is sent first on the next call.
+     *
+     * The kernel may read the pages until the receiver is done with them, which no send queue
+     * counter tells (over loopback acknowledged data still sits in the peer's receive queue).
+     * So pages are released as soon as they are piped, unmapped with MADV_DONTNEED: the kernel
+     * keeps its own reference and the pool gets fresh zero pages on next touch. Spill slots are
+     * punched out and reused once the pipe is empty (see SpillFile::release()).
+     * Requires a pool whose pages cover whole system pages.
+     * @return number of bytes handed to the socket.
+     */
+    template<typename Socket>
+    size_type spliceTo(Socket& socket)
+    {
+        if (!m_pool->isPageAligned())
+            throw ErrnoException("spliceTo requires page sized memory pool pages", EINVAL);
+        
+        if (m_pipe[0] == -1)
+        {
+            if (pipe2(m_pipe, O_CLOEXEC) == -1)
+                throw ErrnoException("Unable to create splice pipe", errno);
+            
+            // Best effort, a bigger pipe means fewer splice calls
+            fcntl(m_pipe[1], F_SETPIPE_SZ, 1024 * 1024);
+        }
+        
+        size_type sent = 0;
+        
+        while(true)
+        {
+            // Fill the pipe with page references
+            while(!m_data.empty())
+            {
+                Page& page = m_data.front();
+                const size_type remain = page.size - m_headOffset;
+                
+                if (remain == 0)
+                {
+                    // Only the write page can be empty, keep it for appending
+                    if (m_data.size() == 1)
+                        break;
+                    retireHeadPage();
+                    continue;
+                }
+                
+                ssize_t res;
+                if (page.isSpilled())
+                {
+                    loff_t offset = page.spillOffset + m_headOffset;
+                    res = splice(m_spillFile->fd(), &offset, m_pipe[1], nullptr, remain, SPLICE_F_NONBLOCK | SPLICE_F_MORE);
+                }
+                else
+                {
+                    struct iovec iov = { static_cast<char*>(page.memory->data()) + m_headOffset, remain };
+                    res = vmsplice(m_pipe[1], &iov, 1, SPLICE_F_NONBLOCK);
+                }
+                
+                if (res == -1)
+                {
+                    if (errno == EAGAIN)
+                        break; // Pipe is full
+                    if (errno == EINTR)
+                        continue;
+                    throw ErrnoException("Unable to splice buffer page to pipe", errno);
+                }
+                
+                m_headOffset += res;
+                m_pipeBytes += res;
+                m_size -= res;
+                
+                if (m_headOffset == page.size)
+                    retireHeadPage();
+            }
+            
+            if (m_pipeBytes == 0)
+                break;
+            
+            ssize_t res = socket.spliceWrite(m_pipe[0], m_pipeBytes);
+            if (res <= 0)
+                break; // Non-blocking socket is full
+            
+            m_pipeBytes -= res;
+            sent += res;
+        }
+        
+        if (m_pipeBytes == 0)
+        {
+            for (off_t offset : m_pipedSlots)
+                m_spillFile->release(offset);
+            m_pipedSlots.clear();
+        }
+        
+        return sent;
+    }
+    
+    // Calls @function(data, size) for the contents of each page, in order
+    template<typename Function>
+    void forEachSegment(Function function)
+    {
+        for (Iterator it = begin(); it != end(); it++)
+            if (it.size)
+                function(static_cast<const T*>(it.data), it.size * sizeof(T));
+    }
+    
     Iterator begin() { return Iterator(this, m_data.begin()); };
     Iterator end() { return Iterator(this, m_data.end()); };
 };
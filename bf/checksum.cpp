@@ -0,0 +1,621 @@
+/*
+ * checksum.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: gianni
+ *
+ * BitForge http://www.bitforge.com.br
+ * Copyright (c) 2012 All Right Reserved,
+ */
+
+#include "checksum.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BF_CHECKSUM_X86
+#endif
+
+namespace bitforge
+{
+
+namespace
+{
+
+/*
+ * Fletcher32 sums are kept reduced modulo 65535. Folding the carries back in, as the original
+ * loop did, gives the same values, and the sums never end up 0 that way, so finalize() maps 0
+ * to 0xffff.
+ * Over n words w[0..n-1]: sum1 += w[0] + ... + w[n-1] and sum2 += n * sum1 + n * w[0] + ... + 1 * w[n-1]
+ */
+
+const uint32_t FletcherModulo = 65535;
+
+// Words per block the 32 bit scalar sums can take without overflowing
+const std::size_t FletcherScalarBlock = 360;
+
+// Below this many words reducing the vector lanes costs more than the vector loops save
+const std::size_t FletcherVectorMinimum = 64;
+
+inline uint16_t loadWord(const char* data)
+{
+    uint16_t word;
+    memcpy(&word, data, sizeof(word));
+    return word;
+}
+
+/****************************** Scalar *****************************************/
+
+void fletcherScalar(uint32_t& sum1, uint32_t& sum2, const char* data, std::size_t words)
+{
+    uint32_t s1 = sum1, s2 = sum2;
+
+    while (words)
+    {
+        std::size_t n = words < FletcherScalarBlock ? words : FletcherScalarBlock;
+        words -= n;
+
+        // Two words at a time to shorten the dependency chains
+        for (; n >= 2; n -= 2)
+        {
+            const uint32_t w0 = loadWord(data);
+            const uint32_t w1 = loadWord(data + 2);
+            s2 += 2 * s1 + 2 * w0 + w1;
+            s1 += w0 + w1;
+            data += 4;
+        }
+
+        if (n)
+        {
+            s1 += loadWord(data);
+            s2 += s1;
+            data += 2;
+        }
+
+        s1 %= FletcherModulo;
+        s2 %= FletcherModulo;
+    }
+
+    sum1 = s1;
+    sum2 = s2;
+}
+
+#ifdef BF_CHECKSUM_X86
+
+/*
+ * The vector versions widen the words to 32 bit lanes, lane l taking words l, l + L, l + 2L...
+ * Every step adds the lanes' sum1 to their sum2 before adding the next words, so after T
+ * steps word t * L + l was counted T - 1 - t times in sum2 lane l, and its block weight is
+ * L * (T - 1 - t) + (L - l). Lanes can take 360 steps before overflowing.
+ */
+const std::size_t FletcherVectorSteps = 360;
+
+// Adds the lanes of a block of @steps steps of @lanes words to the sums
+void fletcherReduce(uint32_t& sum1, uint32_t& sum2, const uint32_t* s1, const uint32_t* s2, std::size_t lanes, std::size_t steps)
+{
+    uint64_t total1 = 0, total2 = 0;
+
+    for (std::size_t l = 0; l < lanes; l++)
+    {
+        total1 += s1[l];
+        total2 += lanes * static_cast<uint64_t>(s2[l]) + (lanes - l) * static_cast<uint64_t>(s1[l]);
+    }
+
+    const uint64_t words = lanes * steps;
+    sum2 = (sum2 + words % FletcherModulo * sum1 + total2) % FletcherModulo;
+    sum1 = (sum1 + total1) % FletcherModulo;
+}
+
+/****************************** SSE2 *******************************************/
+
+__attribute__((target("sse2")))
+void fletcherSSE2(uint32_t& sum1, uint32_t& sum2, const char* data, std::size_t words)
+{
+    const __m128i zero = _mm_setzero_si128();
+
+    while (words >= FletcherVectorMinimum)
+    {
+        std::size_t steps = words / 8;
+        if (steps > FletcherVectorSteps)
+            steps = FletcherVectorSteps;
+
+        __m128i s1Lo = zero, s1Hi = zero, s2Lo = zero, s2Hi = zero;
+
+        for (std::size_t i = 0; i < steps; i++)
+        {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+            data += 16;
+
+            s2Lo = _mm_add_epi32(s2Lo, s1Lo);
+            s2Hi = _mm_add_epi32(s2Hi, s1Hi);
+            s1Lo = _mm_add_epi32(s1Lo, _mm_unpacklo_epi16(v, zero));
+            s1Hi = _mm_add_epi32(s1Hi, _mm_unpackhi_epi16(v, zero));
+        }
+
+        uint32_t s1[8], s2[8];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(s1), s1Lo);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(s1 + 4), s1Hi);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(s2), s2Lo);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(s2 + 4), s2Hi);
+        fletcherReduce(sum1, sum2, s1, s2, 8, steps);
+
+        words -= steps * 8;
+    }
+
+    fletcherScalar(sum1, sum2, data, words);
+}
+
+/****************************** AVX2 *******************************************/
+
+__attribute__((target("avx2")))
+void fletcherAVX2(uint32_t& sum1, uint32_t& sum2, const char* data, std::size_t words)
+{
+    const __m256i zero = _mm256_setzero_si256();
+
+    while (words >= FletcherVectorMinimum)
+    {
+        std::size_t steps = words / 16;
+        if (steps > FletcherVectorSteps)
+            steps = FletcherVectorSteps;
+
+        __m256i s1Lo = zero, s1Hi = zero, s2Lo = zero, s2Hi = zero;
+
+        for (std::size_t i = 0; i < steps; i++)
+        {
+            const __m256i lo = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)));
+            const __m256i hi = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16)));
+            data += 32;
+
+            s2Lo = _mm256_add_epi32(s2Lo, s1Lo);
+            s2Hi = _mm256_add_epi32(s2Hi, s1Hi);
+            s1Lo = _mm256_add_epi32(s1Lo, lo);
+            s1Hi = _mm256_add_epi32(s1Hi, hi);
+        }
+
+        uint32_t s1[16], s2[16];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(s1), s1Lo);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(s1 + 8), s1Hi);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(s2), s2Lo);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(s2 + 8), s2Hi);
+        fletcherReduce(sum1, sum2, s1, s2, 16, steps);
+
+        words -= steps * 16;
+    }
+
+    // Not fletcherSSE2(), going from AVX to non-VEX SSE code stalls
+    fletcherScalar(sum1, sum2, data, words);
+}
+
+#endif // BF_CHECKSUM_X86
+
+/****************************** CRC tables *************************************/
+
+const uint32_t Crc32cPolynomial = 0x82f63b78;   // Reflected 0x1edc6f41
+const uint32_t Crc32Mpeg2Polynomial = 0x04c11db7;
+
+// Slicing-by-8 tables: [0] is the usual byte table, [k] runs a byte through k more zero bytes
+struct CrcTables
+{
+    uint32_t crc32c[8][256];
+    uint32_t mpeg2[8][256];
+
+    CrcTables()
+    {
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t reflected = i, msbFirst = i << 24;
+            for (int bit = 0; bit < 8; bit++)
+            {
+                reflected = (reflected >> 1) ^ (reflected & 1 ? Crc32cPolynomial : 0);
+                msbFirst = (msbFirst << 1) ^ (msbFirst & 0x80000000 ? Crc32Mpeg2Polynomial : 0);
+            }
+            crc32c[0][i] = reflected;
+            mpeg2[0][i] = msbFirst;
+        }
+
+        for (int k = 1; k < 8; k++)
+        {
+            for (int i = 0; i < 256; i++)
+            {
+                crc32c[k][i] = (crc32c[k - 1][i] >> 8) ^ crc32c[0][crc32c[k - 1][i] & 0xff];
+                mpeg2[k][i] = (mpeg2[k - 1][i] << 8) ^ mpeg2[0][mpeg2[k - 1][i] >> 24];
+            }
+        }
+    }
+};
+
+const CrcTables& crcTables()
+{
+    static const CrcTables s_tables;
+    return s_tables;
+}
+
+inline uint32_t loadBigEndian32(const uint8_t* data)
+{
+    return static_cast<uint32_t>(data[0]) << 24 | static_cast<uint32_t>(data[1]) << 16 |
+           static_cast<uint32_t>(data[2]) << 8 | data[3];
+}
+
+inline uint64_t loadLittleEndian64(const uint8_t* data)
+{
+    uint64_t value;
+    memcpy(&value, data, sizeof(value));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap64(value);
+#endif
+    return value;
+}
+
+/****************************** Scalar CRCs ************************************/
+
+uint32_t crc32cScalar(uint32_t crc, const uint8_t* data, std::size_t len)
+{
+    const CrcTables& tables = crcTables();
+    const uint32_t (*t)[256] = tables.crc32c;
+
+    for (; len >= 8; len -= 8, data += 8)
+    {
+        const uint64_t word = loadLittleEndian64(data) ^ crc;
+        crc = t[7][word & 0xff] ^ t[6][(word >> 8) & 0xff] ^ t[5][(word >> 16) & 0xff] ^ t[4][(word >> 24) & 0xff] ^
+              t[3][(word >> 32) & 0xff] ^ t[2][(word >> 40) & 0xff] ^ t[1][(word >> 48) & 0xff] ^ t[0][word >> 56];
+    }
+
+    while (len--)
+        crc = (crc >> 8) ^ t[0][(crc ^ *data++) & 0xff];
+
+    return crc;
+}
+
+uint32_t crc32Mpeg2Scalar(uint32_t crc, const uint8_t* data, std::size_t len)
+{
+    const CrcTables& tables = crcTables();
+    const uint32_t (*t)[256] = tables.mpeg2;
+
+    for (; len >= 8; len -= 8, data += 8)
+    {
+        const uint32_t hi = loadBigEndian32(data) ^ crc;
+        const uint32_t lo = loadBigEndian32(data + 4);
+        crc = t[7][hi >> 24] ^ t[6][(hi >> 16) & 0xff] ^ t[5][(hi >> 8) & 0xff] ^ t[4][hi & 0xff] ^
+              t[3][lo >> 24] ^ t[2][(lo >> 16) & 0xff] ^ t[1][(lo >> 8) & 0xff] ^ t[0][lo & 0xff];
+    }
+
+    while (len--)
+        crc = (crc << 8) ^ t[0][(crc >> 24) ^ *data++];
+
+    return crc;
+}
+
+#ifdef BF_CHECKSUM_X86
+
+/****************************** SSE4.2 *****************************************/
+
+__attribute__((target("sse4.2")))
+uint32_t crc32cSSE42(uint32_t crc, const uint8_t* data, std::size_t len)
+{
+    for (; len && reinterpret_cast<uintptr_t>(data) & 7; len--)
+        crc = _mm_crc32_u8(crc, *data++);
+
+#ifdef __x86_64__
+    uint64_t crc64 = crc;
+    for (; len >= 8; len -= 8, data += 8)
+    {
+        uint64_t word;
+        memcpy(&word, data, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+    }
+    crc = static_cast<uint32_t>(crc64);
+#endif
+
+    for (; len >= 4; len -= 4, data += 4)
+    {
+        uint32_t word;
+        memcpy(&word, data, sizeof(word));
+        crc = _mm_crc32_u32(crc, word);
+    }
+
+    while (len--)
+        crc = _mm_crc32_u8(crc, *data++);
+
+    return crc;
+}
+
+/****************************** PCLMULQDQ **************************************/
+
+/*
+ * CRC-32/MPEG-2 by folding: 16 byte blocks, read as 128 bit big endian polynomials, are
+ * multiplied by x^n mod P to move them n bits along and xored into the next ones, which keeps
+ * the value congruent to the data so far modulo P. Four blocks are folded in parallel and the
+ * last 128 bits go through the table code, which completes the division.
+ * The crc register is xored into the first 32 bits of data, like the table code does.
+ */
+const uint64_t FoldX128 = 0xe8a45605;   // x^128 mod P
+const uint64_t FoldX192 = 0xc5b9cd4c;   // x^(128 + 64) mod P
+const uint64_t FoldX512 = 0xe6228b11;   // x^512 mod P
+const uint64_t FoldX576 = 0x8833794c;   // x^(512 + 64) mod P
+
+const std::size_t FoldMinimum = 128;
+
+__attribute__((target("pclmul,ssse3")))
+inline __m128i fold(__m128i value, __m128i constants, __m128i next)
+{
+    return _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(value, constants, 0x11),
+                                       _mm_clmulepi64_si128(value, constants, 0x00)), next);
+}
+
+__attribute__((target("pclmul,ssse3")))
+uint32_t crc32Mpeg2PCLMUL(uint32_t crc, const uint8_t* data, std::size_t len)
+{
+    if (len < FoldMinimum)
+        return crc32Mpeg2Scalar(crc, data, len);
+
+    const __m128i reverse = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const __m128i fold128 = _mm_set_epi64x(FoldX192, FoldX128);
+    const __m128i fold512 = _mm_set_epi64x(FoldX576, FoldX512);
+
+    const __m128i* blocks = reinterpret_cast<const __m128i*>(data);
+    __m128i a0 = _mm_shuffle_epi8(_mm_loadu_si128(blocks), reverse);
+    __m128i a1 = _mm_shuffle_epi8(_mm_loadu_si128(blocks + 1), reverse);
+    __m128i a2 = _mm_shuffle_epi8(_mm_loadu_si128(blocks + 2), reverse);
+    __m128i a3 = _mm_shuffle_epi8(_mm_loadu_si128(blocks + 3), reverse);
+    a0 = _mm_xor_si128(a0, _mm_set_epi32(crc, 0, 0, 0));
+    blocks += 4;
+    len -= 64;
+
+    for (; len >= 64; len -= 64, blocks += 4)
+    {
+        a0 = fold(a0, fold512, _mm_shuffle_epi8(_mm_loadu_si128(blocks), reverse));
+        a1 = fold(a1, fold512, _mm_shuffle_epi8(_mm_loadu_si128(blocks + 1), reverse));
+        a2 = fold(a2, fold512, _mm_shuffle_epi8(_mm_loadu_si128(blocks + 2), reverse));
+        a3 = fold(a3, fold512, _mm_shuffle_epi8(_mm_loadu_si128(blocks + 3), reverse));
+    }
+
+    __m128i a = fold(a0, fold128, a1);
+    a = fold(a, fold128, a2);
+    a = fold(a, fold128, a3);
+
+    for (; len >= 16; len -= 16, blocks++)
+        a = fold(a, fold128, _mm_shuffle_epi8(_mm_loadu_si128(blocks), reverse));
+
+    uint8_t remainder[16];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(remainder), _mm_shuffle_epi8(a, reverse));
+
+    crc = crc32Mpeg2Scalar(0, remainder, sizeof(remainder));
+    return crc32Mpeg2Scalar(crc, reinterpret_cast<const uint8_t*>(blocks), len);
+}
+
+#endif // BF_CHECKSUM_X86
+
+/****************************** XXH64 ******************************************/
+
+const uint64_t Prime64_1 = 0x9e3779b185ebca87ull;
+const uint64_t Prime64_2 = 0xc2b2ae3d27d4eb4full;
+const uint64_t Prime64_3 = 0x165667b19e3779f9ull;
+const uint64_t Prime64_4 = 0x85ebca77c2b2ae63ull;
+const uint64_t Prime64_5 = 0x27d4eb2f165667c5ull;
+
+inline uint64_t rotateLeft(uint64_t value, int bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+inline uint64_t xxhRound(uint64_t acc, uint64_t input)
+{
+    return rotateLeft(acc + input * Prime64_2, 31) * Prime64_1;
+}
+
+inline uint64_t xxhMerge(uint64_t hash, uint64_t acc)
+{
+    return (hash ^ xxhRound(0, acc)) * Prime64_1 + Prime64_4;
+}
+
+// Consumes whole 32 byte stripes, returns the bytes used
+std::size_t xxhStripes(uint64_t* acc, const uint8_t* data, std::size_t len)
+{
+    uint64_t v1 = acc[0], v2 = acc[1], v3 = acc[2], v4 = acc[3];
+    const uint8_t* p = data;
+
+    for (; len >= 32; len -= 32, p += 32)
+    {
+        v1 = xxhRound(v1, loadLittleEndian64(p));
+        v2 = xxhRound(v2, loadLittleEndian64(p + 8));
+        v3 = xxhRound(v3, loadLittleEndian64(p + 16));
+        v4 = xxhRound(v4, loadLittleEndian64(p + 24));
+    }
+
+    acc[0] = v1; acc[1] = v2; acc[2] = v3; acc[3] = v4;
+    return p - data;
+}
+
+// The hash of @total bytes, @len < 32 of them still to be mixed in
+uint64_t xxhFinalize(const uint64_t* acc, uint64_t seed, uint64_t total, const uint8_t* p, std::size_t len)
+{
+    uint64_t hash;
+
+    if (total >= 32)
+    {
+        hash = rotateLeft(acc[0], 1) + rotateLeft(acc[1], 7) + rotateLeft(acc[2], 12) + rotateLeft(acc[3], 18);
+        for (int i = 0; i < 4; i++)
+            hash = xxhMerge(hash, acc[i]);
+    }
+    else
+        hash = seed + Prime64_5;
+
+    hash += total;
+
+    for (; len >= 8; len -= 8, p += 8)
+        hash = rotateLeft(hash ^ xxhRound(0, loadLittleEndian64(p)), 27) * Prime64_1 + Prime64_4;
+
+    if (len >= 4)
+    {
+        const uint64_t word = static_cast<uint64_t>(p[0]) | static_cast<uint64_t>(p[1]) << 8 |
+                              static_cast<uint64_t>(p[2]) << 16 | static_cast<uint64_t>(p[3]) << 24;
+        hash = rotateLeft(hash ^ word * Prime64_1, 23) * Prime64_2 + Prime64_3;
+        len -= 4;
+        p += 4;
+    }
+
+    while (len--)
+        hash = rotateLeft(hash ^ *p++ * Prime64_5, 11) * Prime64_1;
+
+    hash ^= hash >> 33;
+    hash *= Prime64_2;
+    hash ^= hash >> 29;
+    hash *= Prime64_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+struct ChecksumFunctions
+{
+    void (*fletcher)(uint32_t&, uint32_t&, const char*, std::size_t);
+    uint32_t (*crc32c)(uint32_t, const uint8_t*, std::size_t);
+    uint32_t (*crc32Mpeg2)(uint32_t, const uint8_t*, std::size_t);
+};
+
+ChecksumFunctions selectFunctions()
+{
+    ChecksumFunctions functions = { fletcherScalar, crc32cScalar, crc32Mpeg2Scalar };
+
+#ifdef BF_CHECKSUM_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        functions.fletcher = fletcherAVX2;
+    else if (__builtin_cpu_supports("sse2"))
+        functions.fletcher = fletcherSSE2;
+
+    if (__builtin_cpu_supports("sse4.2"))
+        functions.crc32c = crc32cSSE42;
+
+    if (__builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3"))
+        functions.crc32Mpeg2 = crc32Mpeg2PCLMUL;
+#endif
+
+    return functions;
+}
+
+const ChecksumFunctions& functions()
+{
+    static const ChecksumFunctions s_functions = selectFunctions();
+    return s_functions;
+}
+
+}
+
+void Fletcher32::addWord(uint16_t word)
+{
+    m_sum1 = (m_sum1 + word) % FletcherModulo;
+    m_sum2 = (m_sum2 + m_sum1) % FletcherModulo;
+}
+
+Fletcher32& Fletcher32::update(const void* data, std::size_t len)
+{
+    const char* p = static_cast<const char*>(data);
+
+    if (len && m_pending != -1)
+    {
+        const char word[2] = { static_cast<char>(m_pending), *p };
+        addWord(loadWord(word));
+        m_pending = -1;
+        p++;
+        len--;
+    }
+
+    if (len / 2 < FletcherVectorMinimum)
+        fletcherScalar(m_sum1, m_sum2, p, len / 2);
+    else
+        functions().fletcher(m_sum1, m_sum2, p, len / 2);
+
+    if (len & 1)
+        m_pending = static_cast<unsigned char>(p[len - 1]);
+
+    return *this;
+}
+
+uint32_t Fletcher32::finalize() const
+{
+    const uint32_t sum1 = m_sum1 % FletcherModulo;
+    const uint32_t sum2 = m_sum2 % FletcherModulo;
+    return (sum2 ? sum2 : 0xffff) << 16 | (sum1 ? sum1 : 0xffff);
+}
+
+uint32_t fletcher32(const char* data, std::size_t len)
+{
+    return Fletcher32().update(data, len).finalize();
+}
+
+Crc32c& Crc32c::update(const void* data, std::size_t len)
+{
+    m_crc = functions().crc32c(m_crc, static_cast<const uint8_t*>(data), len);
+    return *this;
+}
+
+uint32_t crc32c(const void* data, std::size_t len)
+{
+    return Crc32c().update(data, len).finalize();
+}
+
+Crc32Mpeg2& Crc32Mpeg2::update(const void* data, std::size_t len)
+{
+    m_crc = functions().crc32Mpeg2(m_crc, static_cast<const uint8_t*>(data), len);
+    return *this;
+}
+
+uint32_t crc32Mpeg2(const void* data, std::size_t len)
+{
+    return Crc32Mpeg2().update(data, len).finalize();
+}
+
+Hash64::Hash64(uint64_t seed):
+    m_seed(seed), m_total(0), m_stripeSize(0)
+{
+    m_acc[0] = seed + Prime64_1 + Prime64_2;
+    m_acc[1] = seed + Prime64_2;
+    m_acc[2] = seed;
+    m_acc[3] = seed - Prime64_1;
+}
+
+Hash64& Hash64::update(const void* data, std::size_t len)
+{
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    m_total += len;
+
+    if (m_stripeSize)
+    {
+        const std::size_t n = std::min(len, sizeof(m_stripe) - m_stripeSize);
+        memcpy(m_stripe + m_stripeSize, p, n);
+        m_stripeSize += n;
+        p += n;
+        len -= n;
+
+        if (m_stripeSize < sizeof(m_stripe))
+            return *this;
+
+        xxhStripes(m_acc, m_stripe, sizeof(m_stripe));
+        m_stripeSize = 0;
+    }
+
+    const std::size_t used = xxhStripes(m_acc, p, len);
+    memcpy(m_stripe, p + used, len - used);
+    m_stripeSize = len - used;
+
+    return *this;
+}
+
+uint64_t Hash64::finalize() const
+{
+    return xxhFinalize(m_acc, m_seed, m_total, m_stripe, m_stripeSize);
+}
+
+uint64_t hash64(const void* data, std::size_t len, uint64_t seed)
+{
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+
+    uint64_t acc[4] = { seed + Prime64_1 + Prime64_2, seed + Prime64_2, seed, seed - Prime64_1 };
+    const std::size_t used = len >= 32 ? xxhStripes(acc, p, len) : 0;
+
+    return xxhFinalize(acc, seed, len, p + used, len - used);
+}
+
+} // bitforge
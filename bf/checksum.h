@@ -0,0 +1,141 @@
+/*
+ * checksum.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: gianni
+ *
+ * BitForge http://www.bitforge.com.br
+ * Copyright (c) 2012 All Right Reserved,
+ */
+
+#ifndef __INCLUDE_LIBBF_CHECKSUM_H_
+#define __INCLUDE_LIBBF_CHECKSUM_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace bitforge
+{
+
+/**
+ * @class Fletcher32
+ * @description Incremental fletcher32(). Feeding the data in any number of pieces, of any
+ * length, gives the same result as a single fletcher32() call over all of it.
+ */
+class Fletcher32
+{
+private:
+    uint32_t    m_sum1;
+    uint32_t    m_sum2;
+    int         m_pending;  // Odd byte waiting for the next one to make a 16 bit word, or -1
+
+    void addWord(uint16_t word);
+
+public:
+    Fletcher32(): m_sum1(0xffff), m_sum2(0xffff), m_pending(-1) {}
+
+    Fletcher32& update(const void* data, std::size_t len);
+
+    // Every contiguous piece of a SimpleBuffer or CircularBuffer, see their forEachSegment()
+    template<typename Buffer>
+    Fletcher32& update(Buffer& buffer)
+    {
+        buffer.forEachSegment([this](const void* data, std::size_t len) { update(data, len); });
+        return *this;
+    }
+
+    // Like fletcher32(), a last odd byte doesn't count
+    uint32_t finalize() const;
+};
+
+/* Fast hash function */
+uint32_t fletcher32(const char* data, ::std::size_t len);
+
+/**
+ * @class Crc32c
+ * @description CRC-32C (Castagnoli), as used by iSCSI, SCTP and ext4. Uses the SSE4.2 crc32
+ * instruction when the CPU has it.
+ */
+class Crc32c
+{
+private:
+    uint32_t    m_crc;
+
+public:
+    Crc32c(): m_crc(0xffffffff) {}
+
+    Crc32c& update(const void* data, std::size_t len);
+
+    template<typename Buffer>
+    Crc32c& update(Buffer& buffer)
+    {
+        buffer.forEachSegment([this](const void* data, std::size_t len) { update(data, len); });
+        return *this;
+    }
+
+    uint32_t finalize() const { return ~m_crc; }
+};
+
+uint32_t crc32c(const void* data, std::size_t len);
+
+/**
+ * @class Crc32Mpeg2
+ * @description CRC-32/MPEG-2, the CRC_32 of MPEG-TS PSI sections. A whole section, CRC_32
+ * field included, gives 0. Uses PCLMULQDQ folding when the CPU has it.
+ */
+class Crc32Mpeg2
+{
+private:
+    uint32_t    m_crc;
+
+public:
+    Crc32Mpeg2(): m_crc(0xffffffff) {}
+
+    Crc32Mpeg2& update(const void* data, std::size_t len);
+
+    template<typename Buffer>
+    Crc32Mpeg2& update(Buffer& buffer)
+    {
+        buffer.forEachSegment([this](const void* data, std::size_t len) { update(data, len); });
+        return *this;
+    }
+
+    uint32_t finalize() const { return m_crc; }
+};
+
+uint32_t crc32Mpeg2(const void* data, std::size_t len);
+
+/**
+ * @class Hash64
+ * @description 64 bit non-cryptographic hash for hash tables and such, the XXH64 algorithm:
+ * results match other XXH64 implementations.
+ */
+class Hash64
+{
+private:
+    uint64_t    m_acc[4];
+    uint64_t    m_seed;
+    uint64_t    m_total;
+    uint8_t     m_stripe[32];   // Input waiting for a whole 32 byte stripe
+    std::size_t m_stripeSize;
+
+public:
+    explicit Hash64(uint64_t seed = 0);
+
+    Hash64& update(const void* data, std::size_t len);
+
+    template<typename Buffer>
+    Hash64& update(Buffer& buffer)
+    {
+        buffer.forEachSegment([this](const void* data, std::size_t len) { update(data, len); });
+        return *this;
+    }
+
+    uint64_t finalize() const;
+};
+
+uint64_t hash64(const void* data, std::size_t len, uint64_t seed = 0);
+
+} // bitforge
+
+#endif // __INCLUDE_LIBBF_CHECKSUM_H_
@@ -0,0 +1,363 @@
+/*
+ * floatfmt.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: gianni
+ *
+ * BitForge http://www.bitforge.com.br
+ * Copyright (c) 2012 All Right Reserved,
+ */
+
+#include "floatfmt.h"
+#include "inthex.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace bitforge
+{
+
+namespace
+{
+
+/*
+ * Grisu2, from Florian Loitsch's "Printing Floating-Point Numbers Quickly and Accurately
+ * with Integers". Values are handled as a 64 bit significand and a binary exponent (DiyFp)
+ * and scaled by a cached power of ten so the digits come out of integer arithmetic.
+ */
+
+const int SignificandBits = 52;
+const uint64_t HiddenBit = 1ull << SignificandBits;
+
+struct DiyFp
+{
+    uint64_t    f;
+    int         e;
+
+    DiyFp(uint64_t _f, int _e): f(_f), e(_e) {}
+
+    explicit DiyFp(double value)
+    {
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+
+        const int biasedExponent = static_cast<int>((bits >> SignificandBits) & 0x7ff);
+        const uint64_t significand = bits & (HiddenBit - 1);
+
+        if (biasedExponent)
+        {
+            f = significand | HiddenBit;
+            e = biasedExponent - 1075;
+        }
+        else
+        {
+            f = significand;
+            e = -1074;
+        }
+    }
+
+    DiyFp operator-(const DiyFp& other) const
+    {
+        return DiyFp(f - other.f, e);
+    }
+
+    // Upper 64 bits of the product, rounded
+    DiyFp operator*(const DiyFp& other) const
+    {
+        const unsigned __int128 p = static_cast<unsigned __int128>(f) * other.f;
+        uint64_t h = static_cast<uint64_t>(p >> 64);
+        if (static_cast<uint64_t>(p) & (1ull << 63))
+            h++;
+        return DiyFp(h, e + other.e + 64);
+    }
+
+    DiyFp normalize() const
+    {
+        const int shift = __builtin_clzll(f);
+        return DiyFp(f << shift, e - shift);
+    }
+
+    // The halfway points to the neighbouring doubles, with the same exponent as the upper one
+    void normalizedBoundaries(DiyFp& minus, DiyFp& plus) const
+    {
+        plus = DiyFp((f << 1) + 1, e - 1).normalize();
+        minus = (f == HiddenBit) ? DiyFp((f << 2) - 1, e - 2) : DiyFp((f << 1) - 1, e - 1);
+        minus.f <<= minus.e - plus.e;
+        minus.e = plus.e;
+    }
+};
+
+// Normalized 10^-348, 10^-340 ... 10^340
+const uint64_t CachedPowersF[] =
+{
+    0xfa8fd5a0081c0288ull, 0xbaaee17fa23ebf76ull, 0x8b16fb203055ac76ull, 0xcf42894a5dce35eaull,
+    0x9a6bb0aa55653b2dull, 0xe61acf033d1a45dfull, 0xab70fe17c79ac6caull, 0xff77b1fcbebcdc4full,
+    0xbe5691ef416bd60cull, 0x8dd01fad907ffc3cull, 0xd3515c2831559a83ull, 0x9d71ac8fada6c9b5ull,
+    0xea9c227723ee8bcbull, 0xaecc49914078536dull, 0x823c12795db6ce57ull, 0xc21094364dfb5637ull,
+    0x9096ea6f3848984full, 0xd77485cb25823ac7ull, 0xa086cfcd97bf97f4ull, 0xef340a98172aace5ull,
+    0xb23867fb2a35b28eull, 0x84c8d4dfd2c63f3bull, 0xc5dd44271ad3cdbaull, 0x936b9fcebb25c996ull,
+    0xdbac6c247d62a584ull, 0xa3ab66580d5fdaf6ull, 0xf3e2f893dec3f126ull, 0xb5b5ada8aaff80b8ull,
+    0x87625f056c7c4a8bull, 0xc9bcff6034c13053ull, 0x964e858c91ba2655ull, 0xdff9772470297ebdull,
+    0xa6dfbd9fb8e5b88full, 0xf8a95fcf88747d94ull, 0xb94470938fa89bcfull, 0x8a08f0f8bf0f156bull,
+    0xcdb02555653131b6ull, 0x993fe2c6d07b7facull, 0xe45c10c42a2b3b06ull, 0xaa242499697392d3ull,
+    0xfd87b5f28300ca0eull, 0xbce5086492111aebull, 0x8cbccc096f5088ccull, 0xd1b71758e219652cull,
+    0x9c40000000000000ull, 0xe8d4a51000000000ull, 0xad78ebc5ac620000ull, 0x813f3978f8940984ull,
+    0xc097ce7bc90715b3ull, 0x8f7e32ce7bea5c70ull, 0xd5d238a4abe98068ull, 0x9f4f2726179a2245ull,
+    0xed63a231d4c4fb27ull, 0xb0de65388cc8ada8ull, 0x83c7088e1aab65dbull, 0xc45d1df942711d9aull,
+    0x924d692ca61be758ull, 0xda01ee641a708deaull, 0xa26da3999aef774aull, 0xf209787bb47d6b85ull,
+    0xb454e4a179dd1877ull, 0x865b86925b9bc5c2ull, 0xc83553c5c8965d3dull, 0x952ab45cfa97a0b3ull,
+    0xde469fbd99a05fe3ull, 0xa59bc234db398c25ull, 0xf6c69a72a3989f5cull, 0xb7dcbf5354e9beceull,
+    0x88fcf317f22241e2ull, 0xcc20ce9bd35c78a5ull, 0x98165af37b2153dfull, 0xe2a0b5dc971f303aull,
+    0xa8d9d1535ce3b396ull, 0xfb9b7cd9a4a7443cull, 0xbb764c4ca7a44410ull, 0x8bab8eefb6409c1aull,
+    0xd01fef10a657842cull, 0x9b10a4e5e9913129ull, 0xe7109bfba19c0c9dull, 0xac2820d9623bf429ull,
+    0x80444b5e7aa7cf85ull, 0xbf21e44003acdd2dull, 0x8e679c2f5e44ff8full, 0xd433179d9c8cb841ull,
+    0x9e19db92b4e31ba9ull, 0xeb96bf6ebadf77d9ull, 0xaf87023b9bf0ee6bull
+};
+
+const int16_t CachedPowersE[] =
+{
+    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980, -954, -927,
+    -901, -874, -847, -821, -794, -768, -741, -715, -688, -661, -635, -608,
+    -582, -555, -529, -502, -475, -449, -422, -396, -369, -343, -316, -289,
+    -263, -236, -210, -183, -157, -130, -103, -77, -50, -24, 3, 30,
+    56, 83, 109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+    375, 402, 428, 455, 481, 508, 534, 561, 588, 614, 641, 667,
+    694, 720, 747, 774, 800, 827, 853, 880, 907, 933, 960, 986,
+    1013, 1039, 1066
+};
+
+// Cached power c with 10^@k = c, putting the product with a value of exponent @e in [-60, -32]
+DiyFp cachedPower(int e, int& k)
+{
+    const double dk = (-61 - e) * 0.30102999566398114 + 347; // log10(2)
+    int ik = static_cast<int>(dk);
+    if (dk - ik > 0.0)
+        ik++;
+
+    const unsigned index = static_cast<unsigned>((ik >> 3) + 1);
+    k = -(-348 + static_cast<int>(index << 3));
+    return DiyFp(CachedPowersF[index], CachedPowersE[index]);
+}
+
+const uint64_t Pow10[] =
+{
+    1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull,
+    1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull,
+    100000000000000ull, 1000000000000000ull, 10000000000000000ull, 100000000000000000ull,
+    1000000000000000000ull, 10000000000000000000ull
+};
+
+// Moves the last digit down while that brings the result closer to the real value
+void grisuRound(char* buffer, int length, uint64_t delta, uint64_t rest, uint64_t tenKappa, uint64_t wpW)
+{
+    while (rest < wpW && delta - rest >= tenKappa &&
+           (rest + tenKappa < wpW || wpW - rest > rest + tenKappa - wpW))
+    {
+        buffer[length - 1]--;
+        rest += tenKappa;
+    }
+}
+
+// Digits of @wp that stay within @delta of it; @k gets the decimal exponent
+int digitGen(const DiyFp& w, const DiyFp& wp, uint64_t delta, char* buffer, int& k)
+{
+    const DiyFp one(1ull << -wp.e, wp.e);
+    const DiyFp wpW = wp - w;
+
+    uint32_t p1 = static_cast<uint32_t>(wp.f >> -one.e);
+    uint64_t p2 = wp.f & (one.f - 1);
+    int kappa = decimalDigits(p1);
+    int length = 0;
+
+    while (kappa > 0)
+    {
+        const uint32_t divisor = static_cast<uint32_t>(Pow10[kappa - 1]);
+        const uint32_t d = p1 / divisor;
+        p1 %= divisor;
+
+        if (d || length)
+            buffer[length++] = static_cast<char>('0' + d);
+        kappa--;
+
+        const uint64_t rest = (static_cast<uint64_t>(p1) << -one.e) + p2;
+        if (rest <= delta)
+        {
+            k += kappa;
+            grisuRound(buffer, length, delta, rest, Pow10[kappa] << -one.e, wpW.f);
+            return length;
+        }
+    }
+
+    for (;;)
+    {
+        p2 *= 10;
+        delta *= 10;
+
+        const char d = static_cast<char>(p2 >> -one.e);
+        if (d || length)
+            buffer[length++] = static_cast<char>('0' + d);
+        p2 &= one.f - 1;
+        kappa--;
+
+        if (p2 < delta)
+        {
+            k += kappa;
+            const int index = -kappa;
+            grisuRound(buffer, length, delta, p2, one.f, wpW.f * (index < 20 ? Pow10[index] : 0));
+            return length;
+        }
+    }
+}
+
+// Digits of a positive, finite @value; it equals digits * 10^@k
+int grisu2(double value, char* buffer, int& k)
+{
+    const DiyFp v(value);
+    DiyFp wMinus(0, 0), wPlus(0, 0);
+    v.normalizedBoundaries(wMinus, wPlus);
+
+    const DiyFp cmk = cachedPower(wPlus.e, k);
+    const DiyFp w = v.normalize() * cmk;
+    DiyFp wp = wPlus * cmk;
+    DiyFp wm = wMinus * cmk;
+
+    // Stay strictly inside the rounding interval, whatever the multiplications' errors
+    wm.f++;
+    wp.f--;
+
+    return digitGen(w, wp, wp.f - wm.f, buffer, k);
+}
+
+char* writeExponent(char* c, int exponent)
+{
+    *c++ = 'e';
+    if (exponent < 0)
+    {
+        *c++ = '-';
+        exponent = -exponent;
+    }
+    else
+        *c++ = '+';
+
+    return c + u32toa(c, exponent);
+}
+
+// Lays out @length digits times 10^@k, see dtoa()
+char* prettify(char* c, const char* digits, int length, int k)
+{
+    const int point = length + k; // Digits before the decimal point
+
+    if (point > 0 && point <= 21)
+    {
+        if (k >= 0)
+        {
+            // Integer
+            memcpy(c, digits, length);
+            memset(c + length, '0', k);
+            return c + point;
+        }
+
+        memcpy(c, digits, point);
+        c[point] = '.';
+        memcpy(c + point + 1, digits + point, length - point);
+        return c + length + 1;
+    }
+
+    if (point <= 0 && point > -6)
+    {
+        *c++ = '0';
+        *c++ = '.';
+        memset(c, '0', -point);
+        memcpy(c - point, digits, length);
+        return c - point + length;
+    }
+
+    *c++ = digits[0];
+    if (length > 1)
+    {
+        *c++ = '.';
+        memcpy(c, digits + 1, length - 1);
+        c += length - 1;
+    }
+
+    return writeExponent(c, point - 1);
+}
+
+}
+
+std::size_t dtoa(char* buffer, double value)
+{
+    char* c = buffer;
+
+    if (std::isnan(value))
+    {
+        memcpy(c, "nan", 3);
+        return 3;
+    }
+
+    if (std::signbit(value))
+    {
+        *c++ = '-';
+        value = -value;
+    }
+
+    if (std::isinf(value))
+    {
+        memcpy(c, "inf", 3);
+        return (c - buffer) + 3;
+    }
+
+    if (value == 0)
+    {
+        *c = '0';
+        return (c - buffer) + 1;
+    }
+
+    char digits[20];
+    int k;
+    const int length = grisu2(value, digits, k);
+
+    return prettify(c, digits, length, k) - buffer;
+}
+
+std::size_t dtoaFixed(char* buffer, double value, int precision)
+{
+    static const double Scales[] =
+    {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17
+    };
+
+    if (precision < 0)
+        precision = 0;
+    else if (precision > 17)
+        precision = 17;
+
+    const double scaled = std::round(std::fabs(value) * Scales[precision]);
+    if (!(scaled < 18446744073709551616.0)) // Also true for nan and inf
+        return dtoa(buffer, value);
+
+    char* c = buffer;
+    if (std::signbit(value))
+        *c++ = '-';
+
+    const uint64_t digits = static_cast<uint64_t>(scaled);
+    c += u64toa(c, digits / Pow10[precision]);
+
+    if (precision)
+    {
+        *c++ = '.';
+
+        uint64_t fraction = digits % Pow10[precision];
+        for (int i = precision - 1; i >= 0; i--)
+        {
+            c[i] = static_cast<char>('0' + fraction % 10);
+            fraction /= 10;
+        }
+        c += precision;
+    }
+
+    return c - buffer;
+}
+
+} // bitforge
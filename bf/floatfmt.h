@@ -0,0 +1,44 @@
+/*
+ * floatfmt.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: gianni
+ *
+ * BitForge http://www.bitforge.com.br
+ * Copyright (c) 2012 All Right Reserved,
+ */
+
+#ifndef __INCLUDE_LIBBF_FLOATFMT_H_
+#define __INCLUDE_LIBBF_FLOATFMT_H_
+
+#include <cstddef>
+
+namespace bitforge
+{
+
+// Like the integer conversions in inthex.h, these are used instead of snprintf and ostreams:
+// they write into the caller's buffer, don't NUL terminate, return the length and ignore the
+// locale (the decimal point is always '.').
+
+// Room any of the conversions below may need
+const std::size_t DoubleBufferSize = 32;
+
+/**
+ * Shortest digits that read back (strtod) as exactly @value, Grisu2 style. A handful of
+ * values get one digit more than strictly needed, none ever lose precision.
+ * Values in [1e-6, 1e21) are written in plain decimal ("0.1", "1.5", "100"), others with
+ * an exponent ("1e+21", "5e-324"); also "nan", "inf", "-inf" and "-0".
+ */
+std::size_t dtoa(char* buffer, double value);
+
+/**
+ * @value rounded to @precision (0 to 17) decimals, like printf("%.*f"). The rounding is done
+ * on the binary value, so halfway cases may differ from printf in the last digit.
+ * Values whose digits don't fit in 64 bits (roughly 1.8e19 / 10^precision and over) are
+ * written as dtoa() would.
+ */
+std::size_t dtoaFixed(char* buffer, double value, int precision);
+
+} // bitforge
+
+#endif // __INCLUDE_LIBBF_FLOATFMT_H_
@@ -0,0 +1,272 @@
+/*
+ * histogram.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: gianni
+ *
+ * BitForge http://www.bitforge.com.br
+ * Copyright (c) 2012 All Right Reserved,
+ */
+
+#include "histogram.h"
+#include "bf.h"
+
+#include <cmath>
+#include <limits>
+
+namespace bitforge
+{
+
+namespace
+{
+
+const char SerializationMagic = 'H';
+
+std::atomic<uint64_t> s_nextHistogramId(1);
+std::atomic<uint64_t> s_nextThreadId(1);
+
+uint64_t threadId()
+{
+    static thread_local const uint64_t t_id = s_nextThreadId.fetch_add(1, std::memory_order_relaxed);
+    return t_id;
+}
+
+void writeVarint(std::string& out, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out += static_cast<char>((value & 0x7f) | 0x80);
+        value >>= 7;
+    }
+    out += static_cast<char>(value);
+}
+
+uint64_t readVarint(const char*& p, const char* end)
+{
+    uint64_t value = 0;
+
+    for (unsigned shift = 0; shift < 64; shift += 7)
+    {
+        if (p == end)
+            throw ExceptionWithMessage("Truncated histogram data");
+
+        const uint8_t byte = static_cast<uint8_t>(*p++);
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+            return value;
+    }
+
+    throw ExceptionWithMessage("Invalid varint in histogram data");
+}
+
+}
+
+/****************************** HistogramSnapshot ******************************/
+
+HistogramSnapshot::HistogramSnapshot():
+    m_counts(HistogramBuckets, 0),
+    m_count(0),
+    m_sum(0),
+    m_min(std::numeric_limits<uint64_t>::max()),
+    m_max(0)
+{
+}
+
+void HistogramSnapshot::add(uint64_t value, uint64_t count)
+{
+    if (!count)
+        return;
+
+    addBucket(histogramBucket(value), count);
+    addSummary(value * count, value, value);
+}
+
+void HistogramSnapshot::addBucket(std::size_t bucket, uint64_t count)
+{
+    m_counts[bucket] += count;
+    m_count += count;
+}
+
+void HistogramSnapshot::addSummary(uint64_t sum, uint64_t min, uint64_t max)
+{
+    m_sum += sum;
+    m_min = std::min(m_min, min);
+    m_max = std::max(m_max, max);
+}
+
+HistogramSnapshot& HistogramSnapshot::merge(const HistogramSnapshot& other)
+{
+    for (std::size_t i = 0; i < HistogramBuckets; i++)
+        m_counts[i] += other.m_counts[i];
+
+    m_count += other.m_count;
+    addSummary(other.m_sum, other.m_min, other.m_max);
+    return *this;
+}
+
+uint64_t HistogramSnapshot::percentile(double percentile) const
+{
+    if (!m_count)
+        return 0;
+
+    // Rank of the value, from 1
+    const double exact = std::ceil(percentile / 100 * m_count);
+    const uint64_t rank = exact < 1 ? 1 : exact > m_count ? m_count : static_cast<uint64_t>(exact);
+    if (rank == 1)
+        return m_min;
+    if (rank == m_count)
+        return m_max;
+
+    uint64_t seen = 0;
+    std::size_t bucket = 0;
+    for (; bucket < HistogramBuckets; bucket++)
+    {
+        seen += m_counts[bucket];
+        if (seen >= rank)
+            break;
+    }
+
+    const uint64_t low = histogramBucketLow(bucket);
+    const uint64_t high = bucket + 1 < HistogramBuckets ? histogramBucketLow(bucket + 1) - 1 : std::numeric_limits<uint64_t>::max();
+    const uint64_t middle = low + (high - low) / 2;
+
+    return std::max(m_min, std::min(m_max, middle));
+}
+
+std::string HistogramSnapshot::serialize() const
+{
+    std::string out;
+    out += SerializationMagic;
+    out += static_cast<char>(HistogramSubBucketBits);
+
+    writeVarint(out, m_sum);
+    writeVarint(out, min());
+    writeVarint(out, m_max);
+
+    std::size_t previous = 0;
+    for (std::size_t i = 0; i < HistogramBuckets; i++)
+    {
+        if (!m_counts[i])
+            continue;
+
+        writeVarint(out, i - previous);
+        writeVarint(out, m_counts[i]);
+        previous = i + 1;
+    }
+
+    return out;
+}
+
+HistogramSnapshot HistogramSnapshot::deserialize(const char* data, std::size_t length)
+{
+    const char* p = data;
+    const char* end = data + length;
+
+    if (length < 2 || p[0] != SerializationMagic)
+        throw ExceptionWithMessage("Not histogram data");
+    if (static_cast<unsigned>(p[1]) != HistogramSubBucketBits)
+        throw ExceptionWithMessage("Histogram data with a different bucket layout");
+    p += 2;
+
+    HistogramSnapshot result;
+    const uint64_t sum = readVarint(p, end);
+    const uint64_t min = readVarint(p, end);
+    const uint64_t max = readVarint(p, end);
+
+    std::size_t bucket = 0;
+    while (p != end)
+    {
+        const uint64_t skip = readVarint(p, end);
+        if (skip >= HistogramBuckets - bucket)
+            throw ExceptionWithMessage("Histogram bucket out of range");
+
+        bucket += skip;
+        result.addBucket(bucket++, readVarint(p, end));
+    }
+
+    if (result.m_count)
+        result.addSummary(sum, min, max);
+
+    return result;
+}
+
+/****************************** LatencyHistogram *******************************/
+
+thread_local LatencyHistogram::ShardCache LatencyHistogram::s_shardCache[LatencyHistogram::ShardCacheSize];
+
+LatencyHistogram::Shard::Shard(uint64_t _owner):
+    sum(0),
+    min(std::numeric_limits<uint64_t>::max()),
+    max(0),
+    owner(_owner),
+    next(nullptr)
+{
+    for (std::size_t i = 0; i < HistogramBuckets; i++)
+        counts[i].store(0, std::memory_order_relaxed);
+}
+
+LatencyHistogram::LatencyHistogram():
+    m_id(s_nextHistogramId.fetch_add(1, std::memory_order_relaxed)),
+    m_shards(nullptr)
+{
+}
+
+LatencyHistogram::~LatencyHistogram()
+{
+    Shard* shard = m_shards.load(std::memory_order_acquire);
+    while (shard)
+    {
+        Shard* next = shard->next;
+        delete shard;
+        shard = next;
+    }
+}
+
+LatencyHistogram::Shard& LatencyHistogram::addShard(ShardCache& cache)
+{
+    const uint64_t thread = threadId();
+
+    // The cache entry may have been taken by another histogram, look for our old shard first
+    Shard* shard = m_shards.load(std::memory_order_acquire);
+    while (shard && shard->owner != thread)
+        shard = shard->next;
+
+    if (!shard)
+    {
+        shard = new Shard(thread);
+        shard->next = m_shards.load(std::memory_order_relaxed);
+        while (!m_shards.compare_exchange_weak(shard->next, shard, std::memory_order_release, std::memory_order_relaxed))
+            ;
+    }
+
+    cache.histogram = m_id;
+    cache.shard = shard;
+    return *shard;
+}
+
+HistogramSnapshot LatencyHistogram::snapshot() const
+{
+    HistogramSnapshot result;
+
+    for (Shard* shard = m_shards.load(std::memory_order_acquire); shard; shard = shard->next)
+    {
+        uint64_t count = 0;
+        for (std::size_t i = 0; i < HistogramBuckets; i++)
+        {
+            const uint64_t n = shard->counts[i].load(std::memory_order_acquire);
+            if (n)
+            {
+                result.addBucket(i, n);
+                count += n;
+            }
+        }
+
+        if (count)
+            result.addSummary(shard->sum.load(std::memory_order_relaxed), shard->min.load(std::memory_order_relaxed),
+                              shard->max.load(std::memory_order_relaxed));
+    }
+
+    return result;
+}
+
+} // bitforge
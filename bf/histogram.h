@@ -0,0 +1,205 @@
+/*
+ * histogram.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: gianni
+ *
+ * BitForge http://www.bitforge.com.br
+ * Copyright (c) 2012 All Right Reserved,
+ */
+
+#ifndef __INCLUDE_LIBBF_HISTOGRAM_H_
+#define __INCLUDE_LIBBF_HISTOGRAM_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <bf/timer.h>
+
+namespace bitforge
+{
+
+/*
+ * Log-linear buckets, like HdrHistogram: values under 32 get a bucket each, then every power
+ * of two range is split in 32 equal buckets, so a bucket is never wider than 1/32 of its values.
+ */
+const unsigned HistogramSubBucketBits = 5;
+const std::size_t HistogramSubBuckets = std::size_t(1) << HistogramSubBucketBits;
+const std::size_t HistogramBuckets = (65 - HistogramSubBucketBits) * HistogramSubBuckets;
+
+inline std::size_t histogramBucket(uint64_t value)
+{
+    if (value < HistogramSubBuckets)
+        return static_cast<std::size_t>(value);
+
+    const unsigned exponent = 63 - __builtin_clzll(value);
+    const unsigned shift = exponent - HistogramSubBucketBits;
+    return (shift + 1) * HistogramSubBuckets + static_cast<std::size_t>((value >> shift) & (HistogramSubBuckets - 1));
+}
+
+// Smallest value of @bucket
+inline uint64_t histogramBucketLow(std::size_t bucket)
+{
+    if (bucket < HistogramSubBuckets)
+        return bucket;
+
+    const unsigned shift = static_cast<unsigned>(bucket / HistogramSubBuckets - 1);
+    return static_cast<uint64_t>(HistogramSubBuckets + bucket % HistogramSubBuckets) << shift;
+}
+
+/**
+ * @class HistogramSnapshot
+ * @description Plain copy of a histogram's counts: merge them, ask for percentiles, send them
+ * somewhere with serialize().
+ */
+class HistogramSnapshot
+{
+private:
+    std::vector<uint64_t>   m_counts;
+    uint64_t                m_count;
+    uint64_t                m_sum;
+    uint64_t                m_min;
+    uint64_t                m_max;
+
+public:
+    HistogramSnapshot();
+
+    void add(uint64_t value, uint64_t count = 1);
+    HistogramSnapshot& merge(const HistogramSnapshot& other);
+
+    // Adds counts by bucket, then the sum and extremes of the values they came from
+    void addBucket(std::size_t bucket, uint64_t count);
+    void addSummary(uint64_t sum, uint64_t min, uint64_t max);
+
+    uint64_t count() const { return m_count; }
+    uint64_t sum() const { return m_sum; }
+    uint64_t min() const { return m_count ? m_min : 0; }
+    uint64_t max() const { return m_max; }
+    double mean() const { return m_count ? static_cast<double>(m_sum) / m_count : 0; }
+
+    /*
+     * Value at or under which @percentile (0 to 100) percent of the values are: the middle of
+     * its bucket, within [min(), max()], or exactly min() and max() at the ends. 0 if empty.
+     */
+    uint64_t percentile(double percentile) const;
+
+    uint64_t countAt(std::size_t bucket) const { return m_counts[bucket]; }
+
+    /*
+     * Compact binary form: summary values and (empty buckets skipped, count) pairs, all as
+     * LEB128 varints. deserialize() throws an ExceptionWithMessage on malformed data.
+     */
+    std::string serialize() const;
+    static HistogramSnapshot deserialize(const char* data, std::size_t length);
+};
+
+/**
+ * @class LatencyHistogram
+ * @description Histogram that any number of threads record values (nanoseconds, usually) into.
+ * Each thread writes to its own shard with plain relaxed stores, so recording is wait-free and
+ * doesn't bounce cache lines between cores. snapshot() merges the shards; it can run at any
+ * time, values being recorded meanwhile may or may not be in it.
+ * A thread's shard lives as long as the histogram.
+ */
+class LatencyHistogram
+{
+private:
+    struct Shard
+    {
+        std::atomic<uint64_t>   counts[HistogramBuckets];
+        std::atomic<uint64_t>   sum;
+        std::atomic<uint64_t>   min;
+        std::atomic<uint64_t>   max;
+        const uint64_t          owner;      // Thread id, see threadId()
+        Shard*                  next;
+
+        explicit Shard(uint64_t _owner);
+    };
+
+    // Per thread cache of histogram id to shard
+    struct ShardCache
+    {
+        uint64_t    histogram;
+        Shard*      shard;
+    };
+
+    static const std::size_t ShardCacheSize = 16;
+    static thread_local ShardCache s_shardCache[ShardCacheSize];
+
+    const uint64_t      m_id;
+    std::atomic<Shard*> m_shards;
+
+    Shard& addShard(ShardCache& cache);
+
+    Shard& localShard()
+    {
+        ShardCache& cache = s_shardCache[m_id % ShardCacheSize];
+        return cache.histogram == m_id ? *cache.shard : addShard(cache);
+    }
+
+    // Only the owner thread writes to a shard's atomics
+    static void increase(std::atomic<uint64_t>& value, uint64_t amount)
+    {
+        value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+public:
+    LatencyHistogram();
+    ~LatencyHistogram();
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    void record(uint64_t value)
+    {
+        Shard& shard = localShard();
+
+        increase(shard.sum, value);
+        if (value < shard.min.load(std::memory_order_relaxed))
+            shard.min.store(value, std::memory_order_relaxed);
+        if (value > shard.max.load(std::memory_order_relaxed))
+            shard.max.store(value, std::memory_order_relaxed);
+
+        // Last and released: a snapshot that sees the count sees the summary too
+        std::atomic<uint64_t>& bucket = shard.counts[histogramBucket(value)];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    HistogramSnapshot snapshot() const;
+};
+
+/**
+ * @class LatencyRecorder
+ * @description Records the nanoseconds between its construction and destruction in a LatencyHistogram.
+ *
+ *   static LatencyHistogram s_readLatency;
+ *   {
+ *       LatencyRecorder recorder(s_readLatency);
+ *       socket.read(...);
+ *   }
+ */
+class LatencyRecorder
+{
+private:
+    LatencyHistogram&   m_histogram;
+    const uint64_t      m_start;
+
+public:
+    explicit LatencyRecorder(LatencyHistogram& histogram): m_histogram(histogram), m_start(MonotonicClock::ticks()) {}
+
+    LatencyRecorder(const LatencyRecorder&) = delete;
+    LatencyRecorder& operator=(const LatencyRecorder&) = delete;
+
+    ~LatencyRecorder()
+    {
+        const int64_t elapsed = MonotonicClock::toNanoseconds(MonotonicClock::endTicks() - m_start);
+        m_histogram.record(elapsed > 0 ? elapsed : 0);
+    }
+};
+
+} // bitforge
+
+#endif // __INCLUDE_LIBBF_HISTOGRAM_H_
@@ -0,0 +1,83 @@
+/*
+ * intern.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: gianni
+ *
+ * BitForge http://www.bitforge.com.br
+ * Copyright (c) 2012 All Right Reserved,
+ */
+
+#include "intern.h"
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace bitforge
+{
+
+namespace
+{
+
+// The table is split in shards, each with its own lock, so threads interning different
+// strings rarely contend.
+class InternTable
+{
+private:
+    static const std::size_t ShardCount = 64;
+
+    struct Shard
+    {
+        std::mutex                                                          lock;
+        std::deque<InternedString::Entry>                                   entries;
+        std::unordered_multimap<std::size_t, const InternedString::Entry*>  index;
+    };
+
+    Shard m_shards[ShardCount];
+
+public:
+    const InternedString::Entry* intern(const char* str, std::size_t length)
+    {
+        const std::size_t hash = stringHash(str, length);
+
+        // Low bits pick the bucket inside the shard, use the high ones for the shard
+        Shard& shard = m_shards[(hash >> 58) % ShardCount];
+
+        std::lock_guard<std::mutex> hold(shard.lock);
+
+        auto range = shard.index.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            const NCString& candidate = it->second->string;
+            if (candidate.length() == length && memcmp(candidate.data(), str, length) == 0)
+                return it->second;
+        }
+
+        shard.entries.emplace_back(str, length, hash);
+        const InternedString::Entry* entry = &shard.entries.back();
+        shard.index.insert(std::make_pair(hash, entry));
+
+        return entry;
+    }
+
+    static InternTable& instance()
+    {
+        static InternTable table;
+        return table;
+    }
+};
+
+}
+
+const NCString InternedString::s_empty("");
+
+const InternedString::Entry* InternedString::intern(const char* str, std::size_t length)
+{
+    if (length == 0)
+        return nullptr;
+
+    return InternTable::instance().intern(str, length);
+}
+
+} // bitforge
@@ -0,0 +1,87 @@
+/*
+ * intern.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: gianni
+ *
+ * BitForge http://www.bitforge.com.br
+ * Copyright (c) 2012 All Right Reserved,
+ */
+
+#ifndef __INCLUDE_LIBBF_INTERN_H_
+#define __INCLUDE_LIBBF_INTERN_H_
+
+#include <functional>
+
+#include <bf/ncstring.h>
+
+namespace bitforge
+{
+
+/**
+ * @class InternedString - Canonical string handle
+ * @description All InternedStrings with the same contents refer to the same entry of a
+ * process wide intern table, so == is a pointer compare and hash() a field load.
+ * Entries are never released; intern protocol names, hosts, interface names and the like,
+ * not arbitrary user input.
+ */
+class InternedString
+{
+public:
+    struct Entry
+    {
+        NCString        string;
+        std::size_t     hash;
+
+        Entry(const char* str, std::size_t length, std::size_t _hash): string(str, length), hash(_hash) {}
+    };
+
+private:
+    const Entry* m_entry = nullptr;
+
+    static const Entry* intern(const char* str, std::size_t length);
+    static const NCString s_empty;
+
+public:
+    InternedString() {}
+
+    explicit InternedString(const char* str): m_entry(intern(str, strlen(str))) {}
+    InternedString(const char* str, std::size_t length): m_entry(intern(str, length)) {}
+    explicit InternedString(const NCString& str): m_entry(intern(str.data(), str.length())) {}
+    explicit InternedString(const std::string& str): m_entry(intern(str.data(), str.length())) {}
+
+    const NCString& str() const { return m_entry ? m_entry->string : s_empty; }
+    const char* c_str() const { return str().c_str(); }
+    std::size_t length() const { return m_entry ? m_entry->string.length() : 0; }
+    bool empty() const { return m_entry == nullptr; }
+
+    std::size_t hash() const { return m_entry ? m_entry->hash : stringHash(nullptr, 0); }
+
+    bool operator==(const InternedString& other) const { return m_entry == other.m_entry; }
+    bool operator!=(const InternedString& other) const { return m_entry != other.m_entry; }
+
+    // Arbitrary but stable order, for ordered containers
+    bool operator<(const InternedString& other) const { return m_entry < other.m_entry; }
+
+    operator const NCString&() const { return str(); }
+};
+
+inline std::ostream& operator<<(std::ostream& stream, const InternedString& string)
+{
+    return stream << string.str();
+}
+
+} // bitforge
+
+namespace std
+{
+
+template<>
+struct hash<bitforge::InternedString>
+{
+    std::size_t operator()(const bitforge::InternedString& str) const { return str.hash(); }
+};
+
+} // std
+
+#endif // __INCLUDE_LIBBF_INTERN_H_
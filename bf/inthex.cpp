@@ -0,0 +1,251 @@
+/*
+ * inthex.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: gianni
+ *
+ * BitForge http://www.bitforge.com.br
+ * Copyright (c) 2012 All Right Reserved,
+ */
+
+#include "inthex.h"
+
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BF_INTHEX_X86
+#endif
+
+namespace bitforge
+{
+
+namespace
+{
+
+const char HexUpper[] = "0123456789ABCDEF";
+const char HexLower[] = "0123456789abcdef";
+
+// Digit values, -1 for anything that is not a hex digit
+struct HexValues
+{
+    int8_t values[256];
+
+    HexValues()
+    {
+        for (int i = 0; i < 256; i++)
+            values[i] = -1;
+        for (int i = 0; i < 10; i++)
+            values['0' + i] = i;
+        for (int i = 0; i < 6; i++)
+            values['a' + i] = values['A' + i] = 10 + i;
+    }
+
+    int operator()(char c) const { return values[static_cast<unsigned char>(c)]; }
+};
+
+const HexValues& hexValues()
+{
+    static const HexValues s_values;
+    return s_values;
+}
+
+/****************************** Scalar *****************************************/
+
+void bytesToHexScalar(char* dst, const uint8_t* src, std::size_t length, const char* digits)
+{
+    for (std::size_t i = 0; i < length; i++)
+    {
+        *dst++ = digits[src[i] >> 4];
+        *dst++ = digits[src[i] & 0xf];
+    }
+}
+
+std::size_t hexToBytesScalar(uint8_t* dst, const char* src, std::size_t length)
+{
+    const HexValues& values = hexValues();
+
+    std::size_t i = 0;
+    for (; i + 1 < length; i += 2)
+    {
+        const int hi = values(src[i]);
+        const int lo = values(src[i + 1]);
+
+        if (hi < 0)
+            return i;
+        if (lo < 0)
+            return i + 1;
+
+        *dst++ = (hi << 4) | lo;
+    }
+
+    // Also right for an odd digit out, which can't be decoded either way
+    return i;
+}
+
+#ifdef BF_INTHEX_X86
+
+/****************************** SSSE3 ******************************************/
+
+__attribute__((target("ssse3")))
+void bytesToHexSSSE3(char* dst, const uint8_t* src, std::size_t length, const char* digits)
+{
+    const __m128i table = _mm_loadu_si128(reinterpret_cast<const __m128i*>(digits));
+    const __m128i nibble = _mm_set1_epi8(0xf);
+
+    std::size_t i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i hi = _mm_shuffle_epi8(table, _mm_and_si128(_mm_srli_epi16(bytes, 4), nibble));
+        const __m128i lo = _mm_shuffle_epi8(table, _mm_and_si128(bytes, nibble));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * i), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+
+    bytesToHexScalar(dst + 2 * i, src + i, length - i, digits);
+}
+
+// Digit values of 16 chars, @valid gets a bit per char that is a hex digit
+__attribute__((target("ssse3")))
+inline __m128i hexValuesSSSE3(__m128i chars, uint32_t& valid)
+{
+    const __m128i digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    const __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+
+    const __m128i letter = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const __m128i isLetter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+
+    valid = _mm_movemask_epi8(_mm_or_si128(isDigit, isLetter));
+
+    return _mm_or_si128(_mm_and_si128(isDigit, digit),
+                        _mm_and_si128(isLetter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+}
+
+__attribute__((target("ssse3")))
+std::size_t hexToBytesSSSE3(uint8_t* dst, const char* src, std::size_t length)
+{
+    // Each pair of digit values becomes hi * 16 + lo
+    const __m128i weights = _mm_set1_epi16(0x0110);
+
+    std::size_t i = 0;
+    for (; i + 32 <= length; i += 32)
+    {
+        uint32_t valid0, valid1;
+        const __m128i v0 = hexValuesSSSE3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)), valid0);
+        const __m128i v1 = hexValuesSSSE3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 16)), valid1);
+
+        if ((valid0 & valid1) != 0xffff)
+            break; // The scalar code finds and reports the bad digit
+
+        const __m128i bytes = _mm_packus_epi16(_mm_maddubs_epi16(v0, weights), _mm_maddubs_epi16(v1, weights));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i / 2), bytes);
+    }
+
+    return i + hexToBytesScalar(dst + i / 2, src + i, length - i);
+}
+
+/****************************** AVX2 *******************************************/
+
+__attribute__((target("avx2")))
+void bytesToHexAVX2(char* dst, const uint8_t* src, std::size_t length, const char* digits)
+{
+    const __m256i table = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(digits)));
+    const __m256i nibble = _mm256_set1_epi8(0xf);
+
+    std::size_t i = 0;
+    for (; i + 32 <= length; i += 32)
+    {
+        const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        const __m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(bytes, 4), nibble));
+        const __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(bytes, nibble));
+
+        // Unpacking works within 128 bit lanes: bytes 0-7 and 16-23, then 8-15 and 24-31
+        const __m256i first = _mm256_unpacklo_epi8(hi, lo);
+        const __m256i second = _mm256_unpackhi_epi8(hi, lo);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 2 * i), _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 2 * i + 32), _mm256_permute2x128_si256(first, second, 0x31));
+    }
+
+    bytesToHexSSSE3(dst + 2 * i, src + i, length - i, digits);
+}
+
+__attribute__((target("avx2")))
+inline __m256i hexValuesAVX2(__m256i chars, uint32_t& valid)
+{
+    const __m256i digit = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+    const __m256i isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+
+    const __m256i letter = _mm256_sub_epi8(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    const __m256i isLetter = _mm256_cmpeq_epi8(_mm256_min_epu8(letter, _mm256_set1_epi8(5)), letter);
+
+    valid = _mm256_movemask_epi8(_mm256_or_si256(isDigit, isLetter));
+
+    return _mm256_or_si256(_mm256_and_si256(isDigit, digit),
+                           _mm256_and_si256(isLetter, _mm256_add_epi8(letter, _mm256_set1_epi8(10))));
+}
+
+__attribute__((target("avx2")))
+std::size_t hexToBytesAVX2(uint8_t* dst, const char* src, std::size_t length)
+{
+    const __m256i weights = _mm256_set1_epi16(0x0110);
+
+    std::size_t i = 0;
+    for (; i + 64 <= length; i += 64)
+    {
+        uint32_t valid0, valid1;
+        const __m256i v0 = hexValuesAVX2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)), valid0);
+        const __m256i v1 = hexValuesAVX2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 32)), valid1);
+
+        if ((valid0 & valid1) != 0xffffffffu)
+            break;
+
+        // Packing works within lanes too, put the quarters back in order
+        const __m256i packed = _mm256_packus_epi16(_mm256_maddubs_epi16(v0, weights), _mm256_maddubs_epi16(v1, weights));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i / 2), _mm256_permute4x64_epi64(packed, 0xd8));
+    }
+
+    return i + hexToBytesSSSE3(dst + i / 2, src + i, length - i);
+}
+
+#endif // BF_INTHEX_X86
+
+struct HexFunctions
+{
+    void (*bytesToHex)(char*, const uint8_t*, std::size_t, const char*);
+    std::size_t (*hexToBytes)(uint8_t*, const char*, std::size_t);
+};
+
+HexFunctions selectFunctions()
+{
+#ifdef BF_INTHEX_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return { bytesToHexAVX2, hexToBytesAVX2 };
+    if (__builtin_cpu_supports("ssse3"))
+        return { bytesToHexSSSE3, hexToBytesSSSE3 };
+#endif
+    return { bytesToHexScalar, hexToBytesScalar };
+}
+
+const HexFunctions& functions()
+{
+    static const HexFunctions s_functions = selectFunctions();
+    return s_functions;
+}
+
+}
+
+void bytesToHex(char* dst, const void* src, std::size_t length, HexCase hexCase)
+{
+    functions().bytesToHex(dst, static_cast<const uint8_t*>(src), length, hexCase == hcLower ? HexLower : HexUpper);
+}
+
+std::size_t hexToBytes(void* dst, const char* src, std::size_t length)
+{
+    return functions().hexToBytes(static_cast<uint8_t*>(dst), src, length);
+}
+
+} // bitforge
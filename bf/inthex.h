@@ -13,9 +13,12 @@
 
 #define UNUSED(ARG) do { (void(ARG)) } while (false)
 
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <ctime>
 #include <math.h>
+#include <type_traits>
 #include <unistd.h>
 
 #include <bf/ncstring.h>
@@ -25,17 +28,159 @@ namespace bitforge
 
 // These are used instead of snprintf, lexical_cast or stringstream due to their lack of availability
 
+// Header only tables; the template lets every translation unit share one definition
+template<typename T = void>
+struct DecimalTables
+{
+    static const char pairs[201];       // "00" "01" ... "99"
+    static const uint64_t thresholds[20]; // Lowest value with index + 1 digits: 0, 10 .. 10^19
+};
+
+template<typename T>
+const char DecimalTables<T>::pairs[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+
+template<typename T>
+const uint64_t DecimalTables<T>::thresholds[20] =
+{
+    0ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull,
+    1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull,
+    100000000000000ull, 1000000000000000ull, 10000000000000000ull, 100000000000000000ull,
+    1000000000000000000ull, 10000000000000000000ull
+};
+
+// Decimal digits in @val: log2 from the highest set bit, times log10(2) ~ 1233/4096, then
+// one table compare to correct it
+inline unsigned decimalDigits(uint32_t val)
+{
+    const unsigned t = ((32 - __builtin_clz(val | 1)) * 1233) >> 12;
+    return t - (val < DecimalTables<>::thresholds[t]) + 1;
+}
+
+inline unsigned decimalDigits(uint64_t val)
+{
+    const unsigned t = ((64 - __builtin_clzll(val | 1)) * 1233) >> 12;
+    return t - (val < DecimalTables<>::thresholds[t]) + 1;
+}
+
+// Writes the digits of @val backwards, ending just before @end, two at a time
+template<typename T>
+inline void writeDecimal(char* end, T val)
+{
+    while (val >= 100)
+    {
+        const char* pair = DecimalTables<>::pairs + (val % 100) * 2;
+        val /= 100;
+        *--end = pair[1];
+        *--end = pair[0];
+    }
+
+    if (val >= 10)
+    {
+        const char* pair = DecimalTables<>::pairs + val * 2;
+        *--end = pair[1];
+        *--end = pair[0];
+    }
+    else
+        *--end = '0' + val;
+}
+
+/**
+ * Left aligned conversions: the digits are written at @buffer, which needs room for 10
+ * (u32toa), 11 (i32toa) or 20 (u64toa, i64toa) chars, and their count is returned.
+ * Nothing is NUL terminated.
+ */
+inline std::size_t u32toa(char* buffer, uint32_t val)
+{
+    const unsigned digits = decimalDigits(val);
+    writeDecimal(buffer + digits, val);
+    return digits;
+}
+
+inline std::size_t i32toa(char* buffer, int32_t val)
+{
+    if (val >= 0)
+        return u32toa(buffer, val);
+
+    *buffer = '-';
+    return u32toa(buffer + 1, 0u - static_cast<uint32_t>(val)) + 1;
+}
+
+inline std::size_t u64toa(char* buffer, uint64_t val)
+{
+    // 32 bit divisions are a lot cheaper
+    if (val <= 0xffffffffu)
+        return u32toa(buffer, static_cast<uint32_t>(val));
+
+    const unsigned digits = decimalDigits(val);
+    writeDecimal(buffer + digits, val);
+    return digits;
+}
+
+inline std::size_t i64toa(char* buffer, int64_t val)
+{
+    if (val >= 0)
+        return u64toa(buffer, val);
+
+    *buffer = '-';
+    return u64toa(buffer + 1, 0ull - static_cast<uint64_t>(val)) + 1;
+}
+
+enum HexCase
+{
+    hcUpper,
+    hcLower
+};
+
+// Writes the last @N chars of a fixed width field, ending just before @end
+template<unsigned N, unsigned Base, char Pad, HexCase Case>
+struct FixedDigits
+{
+    template<typename T>
+    static void write(char* end, T val, bool last)
+    {
+        const char* digits = Case == hcUpper ? "0123456789ABCDEF" : "0123456789abcdef";
+
+        // Past the first digit, zeros are padding
+        end[-1] = (last || Pad == '0' || val) ? digits[val % Base] : Pad;
+        FixedDigits<N - 1, Base, Pad, Case>::write(end - 1, val / Base, false);
+    }
+};
+
+template<unsigned Base, char Pad, HexCase Case>
+struct FixedDigits<0, Base, Pad, Case>
+{
+    template<typename T>
+    static void write(char*, T, bool) {}
+};
+
+/**
+ * Writes @val in exactly @Width chars at @buffer, padded on the left with @Pad, and returns
+ * the end. Everything is known at compile time so it becomes a few multiplies and stores.
+ * Values too wide for the field keep their low digits; negative ones are not supported.
+ *
+ *   formatFixed<2>(c, 7)                   "07"
+ *   formatFixed<4, 16>(c, 0xbe)            "00BE"
+ *   formatFixed<5, 10, ' '>(c, 42)         "   42"
+ */
+template<unsigned Width, unsigned Base = 10, char Pad = '0', HexCase Case = hcUpper, typename T>
+inline char* formatFixed(char* buffer, T val)
+{
+    static_assert(Base >= 2 && Base <= 16, "formatFixed supports bases 2 to 16");
+    static_assert(std::is_integral<T>::value, "formatFixed formats integers");
+
+    typedef typename std::make_unsigned<T>::type Unsigned;
+    FixedDigits<Width, Base, Pad, Case>::write(buffer + Width, static_cast<Unsigned>(val), true);
+    return buffer + Width;
+}
+
 inline char* uinttostr(char* buffer, const int bufferSize, unsigned int val)
 {
     char* c = buffer + (bufferSize - 1);
     *c = 0;
 
-    do
-    {
-        *--c = '0' + (val % 10);
-        val /= 10;
-    }
-    while(val);
+    c -= decimalDigits(static_cast<uint32_t>(val));
+    u32toa(c, val);
 
     return c;
 }
@@ -48,13 +193,17 @@ inline std::string uinttostr(unsigned int val)
 
 inline char* inttostr(char* buffer, const int bufferSize, int val)
 {
-    const bool neg = val < 0;
-    char* result =  const_cast<char*>(uinttostr(buffer, bufferSize, abs(val)));
+    char* c = buffer + (bufferSize - 1);
+    *c = 0;
 
-    if(neg)
-        *--result = '-';
+    const uint32_t magnitude = val < 0 ? 0u - static_cast<uint32_t>(val) : val;
+    c -= decimalDigits(magnitude);
+    u32toa(c, magnitude);
 
-    return result;
+    if (val < 0)
+        *--c = '-';
+
+    return c;
 }
 
 inline std::string inttostr(unsigned int val)
@@ -117,32 +266,54 @@ inline char* uint64tostr(char* buffer, const int bufferSize, uint64_t val)
 {
     char* c = buffer + (bufferSize - 1);
     *c = 0;
-    
+
+    c -= decimalDigits(val);
+    u64toa(c, val);
+
+    return c;
+}
+
+inline std::string uint64tostr(uint64_t val)
+{
+    char buffer[64];
+    return uint64tostr(buffer, sizeof(buffer), val);
+}
+
+inline char* uint64tohex(char* buffer, const int bufferSize, uint64_t val)
+{
+    char* c = buffer + (bufferSize - 1);
+    *c = 0;
+
     do
     {
-        *--c = '0' + (val % 10);
-        val /= 10;
+        const unsigned int digit = val & 0xf;
+        *--c = digit <= 9 ? '0' + digit : 'A' + digit - 10;
+        val >>= 4;
     }
     while(val);
-    
+
     return c;
 }
 
-inline std::string uint64tostr(uint64_t val)
+inline std::string uint64tohex(uint64_t val)
 {
-    char buffer[64];
-    return uint64tostr(buffer, sizeof(buffer), val);
+    char buffer[32];
+    return uint64tohex(buffer, sizeof(buffer), val);
 }
 
 inline char* int64tostr(char* buffer, const int bufferSize, int64_t val)
 {
-    const bool neg = val < 0;
-    char* result =  const_cast<char*>(uint64tostr(buffer, bufferSize, llabs(val)));
-    
-    if(neg)
-        *--result = '-';
-    
-    return result;
+    char* c = buffer + (bufferSize - 1);
+    *c = 0;
+
+    const uint64_t magnitude = val < 0 ? 0ull - static_cast<uint64_t>(val) : val;
+    c -= decimalDigits(magnitude);
+    u64toa(c, magnitude);
+
+    if (val < 0)
+        *--c = '-';
+
+    return c;
 }
 
 inline std::string int64tostr(uint64_t val)
@@ -203,6 +374,155 @@ inline uint64_t hextoint64(const std::string& v)
     return hextoint64(v.c_str());
 }
 
+/*
+ * Checked parsers over (pointer, length), a replacement for atoi/strtol that needs no NUL
+ * terminator and never allocates. Like std::from_chars they take no whitespace, '+' or
+ * "0x" prefix; parseInt takes a leading '-'. Only bases 10 and 16 are supported.
+ */
+
+enum ParseError
+{
+    peNone,
+    peNoDigits,     // @end is the start of the string
+    peOverflow      // @end is past all the digits, the value is left alone
+};
+
+struct ParseResult
+{
+    const char* end;    // First char that was not parsed
+    ParseError  error;
+
+    explicit operator bool() const { return error == peNone; }
+};
+
+// Whether the 8 chars in @chunk (loaded little endian) are all decimal digits
+inline bool isEightDigits(uint64_t chunk)
+{
+    return ((chunk & 0xf0f0f0f0f0f0f0f0ull) |
+            (((chunk + 0x0606060606060606ull) & 0xf0f0f0f0f0f0f0f0ull) >> 4)) == 0x3333333333333333ull;
+}
+
+// Value of 8 decimal digits in three multiplies: digit pairs, then quads, then the lot
+inline uint32_t parseEightDigits(uint64_t chunk)
+{
+    chunk -= 0x3030303030303030ull;
+    chunk = (chunk * 10) + (chunk >> 8);
+    chunk = (((chunk & 0x000000ff000000ffull) * (100 + (1000000ull << 32))) +
+             (((chunk >> 16) & 0x000000ff000000ffull) * (1 + (10000ull << 32)))) >> 32;
+    return static_cast<uint32_t>(chunk);
+}
+
+inline int hexDigitValue(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    c |= 0x20;
+    return (c >= 'a' && c <= 'f') ? c - 'a' + 10 : -1;
+}
+
+// Unsigned digits at @str up to @end into @value, which must not exceed @max
+inline ParseResult parseDigits(const char* str, const char* end, uint64_t& value, uint64_t max, int base)
+{
+    const char* p = str;
+    uint64_t v = 0;
+    bool overflow = false;
+
+    if (base == 16)
+    {
+        int digit;
+        for (; p != end && (digit = hexDigitValue(*p)) >= 0; p++)
+        {
+            overflow |= (v >> 60) != 0;
+            v = (v << 4) | digit;
+        }
+    }
+    else
+    {
+        // 8 digits at a time while they last
+        while (end - p >= 8)
+        {
+            uint64_t chunk;
+            memcpy(&chunk, p, 8);
+            if (!isEightDigits(chunk))
+                break;
+
+            overflow |= __builtin_mul_overflow(v, 100000000ull, &v);
+            overflow |= __builtin_add_overflow(v, parseEightDigits(chunk), &v);
+            p += 8;
+        }
+
+        for (; p != end && *p >= '0' && *p <= '9'; p++)
+        {
+            overflow |= __builtin_mul_overflow(v, 10ull, &v);
+            overflow |= __builtin_add_overflow(v, static_cast<uint64_t>(*p - '0'), &v);
+        }
+    }
+
+    if (p == str)
+        return { str, peNoDigits };
+    if (overflow || v > max)
+        return { p, peOverflow };
+
+    value = v;
+    return { p, peNone };
+}
+
+inline ParseResult parseUint(const char* str, std::size_t length, uint64_t& value, int base = 10)
+{
+    return parseDigits(str, str + length, value, UINT64_MAX, base);
+}
+
+inline ParseResult parseUint(const char* str, std::size_t length, uint32_t& value, int base = 10)
+{
+    uint64_t v;
+    const ParseResult res = parseDigits(str, str + length, v, UINT32_MAX, base);
+    if (res)
+        value = static_cast<uint32_t>(v);
+    return res;
+}
+
+inline ParseResult parseInt(const char* str, std::size_t length, int64_t& value, int base = 10)
+{
+    const bool neg = length && *str == '-';
+
+    uint64_t v;
+    const ParseResult res = parseDigits(str + neg, str + length, v, neg ? 0ull - static_cast<uint64_t>(INT64_MIN) : INT64_MAX, base);
+    if (res.error == peNoDigits)
+        return { str, peNoDigits };
+    if (res)
+        value = neg ? static_cast<int64_t>(0ull - v) : static_cast<int64_t>(v);
+    return res;
+}
+
+inline ParseResult parseInt(const char* str, std::size_t length, int32_t& value, int base = 10)
+{
+    const bool neg = length && *str == '-';
+
+    uint64_t v;
+    const ParseResult res = parseDigits(str + neg, str + length, v, neg ? 0x80000000ull : INT32_MAX, base);
+    if (res.error == peNoDigits)
+        return { str, peNoDigits };
+    if (res)
+        value = neg ? static_cast<int32_t>(0u - static_cast<uint32_t>(v)) : static_cast<int32_t>(v);
+    return res;
+}
+
+/*
+ * Bulk hex conversion, for dumps and binary-over-text protocols. These are implemented in
+ * inthex.cpp with SSSE3/AVX2 kernels picked at runtime and a scalar fallback.
+ */
+
+// Writes the 2 * @length hex digits of the @length bytes at @src to @dst, not NUL terminated
+void bytesToHex(char* dst, const void* src, std::size_t length, HexCase hexCase = hcUpper);
+
+/**
+ * Decodes the @length hex digits (either case) at @src into @length / 2 bytes at @dst.
+ * Returns how many digits were decoded: @length on success, otherwise the offset of the
+ * first invalid digit, or @length - 1 when the last digit has no pair. The bytes before
+ * that point are written.
+ */
+std::size_t hexToBytes(void* dst, const char* src, std::size_t length);
+
 }
 
 #endif // __INCLUDE_LIBBF_INTHEX_H_
@@ -1,4 +1,5 @@
 #include "bfsocket.h"
+#include <bf/inthex.h>
 #include <signal.h>
 #include <sstream>
 
@@ -115,22 +116,23 @@ void NetworkInterfaceInfo::dumpInterfacesInfo(int fd)
     std::cout << std::flush;
 }
 
-ServiceAddress::ServiceAddress(std::string _url, ServiceAddress::SocketType _type)
+ServiceAddress::ServiceAddress(NCString _url, ServiceAddress::SocketType _type)
 {
+    // All the parts below are views on (or inline copies of) the url, parsing doesn't allocate
     m_url = _url;
     zero_init(m_sockAddr);
     m_sockAddr.sin_family = AF_INET;
 
     auto protEnd = _url.find("://");
-    if (protEnd == std::string::npos)
+    if (protEnd == NCString::npos)
         THROW_SOCKET_ADDR_EXCEPTION("Missing protocol in '" << _url << "'");
 
     m_protocol = _url.substr(0,protEnd);
 
-    std::string hostPort = _url.substr(protEnd + 3);
+    NCString hostPort = _url.substr(protEnd + 3);
 
-    auto hostEnd = hostPort.find(":");
-    if (hostEnd == std::string::npos)
+    auto hostEnd = hostPort.find(':');
+    if (hostEnd == NCString::npos)
     {
         struct servent* servent = getservbyname(m_protocol.c_str(), nullptr);
         if (!servent)
@@ -138,8 +140,8 @@ ServiceAddress::ServiceAddress(std::string _url, ServiceAddress::SocketType _typ
 
         m_sockAddr.sin_port = servent->s_port;
 
-        hostEnd = hostPort.find("/");
-        if (hostEnd == std::string::npos)
+        hostEnd = hostPort.find('/');
+        if (hostEnd == NCString::npos)
             m_host = hostPort;
         else
         {
@@ -151,14 +153,22 @@ ServiceAddress::ServiceAddress(std::string _url, ServiceAddress::SocketType _typ
     {
         m_host = hostPort.substr(0, hostEnd);
 
-        auto portEnd = hostPort.find("/");
-        if (portEnd == std::string::npos)
-            m_sockAddr.sin_port = htons(atoi(hostPort.substr(hostEnd+1).c_str()));
+        auto portEnd = hostPort.find('/');
+        if (portEnd == NCString::npos)
+            portEnd = hostPort.length();
         else
-        {
-            m_sockAddr.sin_port = htons(atoi(hostPort.substr(hostEnd+1, portEnd).c_str()));
             m_query = hostPort.substr(portEnd);
-        }
+
+        // The whole port must be a number, atoi used to turn garbage into 0
+        const char* portBegin = hostPort.data() + hostEnd + 1;
+        const std::size_t portLength = portEnd > hostEnd ? portEnd - hostEnd - 1 : 0;
+
+        uint32_t port;
+        const ParseResult parsed = parseUint(portBegin, portLength, port);
+        if (!parsed || parsed.end != portBegin + portLength || port > 65535)
+            THROW_SOCKET_ADDR_EXCEPTION("Invalid port in '" << _url << "'");
+
+        m_sockAddr.sin_port = htons(port);
     }
 
     if (m_host.empty())
@@ -169,45 +179,32 @@ ServiceAddress::ServiceAddress(std::string _url, ServiceAddress::SocketType _typ
     // If not set, try to guess
     if (_type == stUNKNOWN && !m_protocol.empty())
     {
-        char c = tolower(m_protocol[0]);
-        switch(c)
+        static constexpr KeywordSet<4> s_protocols = { "http", "https", "tcp", "udp" };
+
+        switch(s_protocols.match(m_protocol.data(), m_protocol.length()))
         {
-            case 'h':
-                if (ICompStr(m_protocol, "http"))
-                {
-                    m_protocolType = ptHTTP;
-                    m_socketType = stTCP;
-                    goto DONE;
-                }
-                else if (ICompStr(m_protocol, "https"))
-                {
-                    m_protocolType = ptHTTPS;
-                    m_socketType = stTCP;
-                    goto DONE;
-                }
+            case 0:
+                m_protocolType = ptHTTP;
+                m_socketType = stTCP;
                 break;
 
-            case 't':
-                if (ICompStr(m_protocol, "tcp"))
-                {
-                    m_socketType = stTCP;
-                    goto DONE;
-                }
+            case 1:
+                m_protocolType = ptHTTPS;
+                m_socketType = stTCP;
                 break;
 
-            case 'u':
-                if (ICompStr(m_protocol, "udp"))
-                {
-                    m_socketType = stUDP;
-                    goto DONE;
-                }
+            case 2:
+                m_socketType = stTCP;
                 break;
-        }
 
-        m_socketType = _type;
+            case 3:
+                m_socketType = stUDP;
+                break;
 
-        DONE:
-        {}
+            default:
+                m_socketType = _type;
+                break;
+        }
     }
     else
         m_socketType = _type;
@@ -383,7 +380,15 @@ ssize_t BFSocket::spliceWrite(int pipeFd, size_t _size)
     }
 
     if(res == -1)
-        THROW_SOCKET_EXCEPTION("Could not splice to Socket - " << strerror(errno));
+    {
+        switch(errno)
+        {
+            case EAGAIN:
+                return 0;
+            default:
+                THROW_SOCKET_EXCEPTION("Could not splice to Socket - " << strerror(errno));
+        }
+    }
     return res;
 }
 
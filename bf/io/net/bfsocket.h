@@ -127,7 +127,7 @@ public:
         ptHTTPS
     };
     
-    ServiceAddress(std::string _url, SocketType _type = stUNKNOWN);
+    ServiceAddress(NCString _url, SocketType _type = stUNKNOWN);
 
 private:
     SocketType  m_socketType = stUNKNOWN;
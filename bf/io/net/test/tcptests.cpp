@@ -9,6 +9,7 @@
 #include <sys/socket.h>
 #include <arpa/inet.h>
 #include <bf/bf.h>
+#include <bf/buffers.h>
 #include <vector>
 #include <algorithm>
 #include <fstream>
@@ -176,6 +177,68 @@ TEST_F(BFTCPSocketTest, TestTCPSocketSpliceWrite)
     close(pipeFd[1]);
 }
 
+TEST_F(BFTCPSocketTest, TestTCPSocketSpliceTo)
+{
+    stringstream ss;
+    ss << "tcp://127.0.0.1:" << m_port;
+    bool isTestingServer = false;
+    createTCPSocket(ss.str(), isTestingServer);
+    
+    // A few pages and a partial one, every byte value present
+    const size_t pageSize = sysconf(_SC_PAGESIZE);
+    vector<char> v(5 * pageSize + 123);
+    for (size_t i = 0; i < v.size(); i++)
+        v[i] = static_cast<char>(i * 7 + i / 251);
+    
+    // The peer only starts reading once the buffer's pages have been reused
+    mutex m;
+    condition_variable cv;
+    bool canRead = false;
+    
+    size_t received = 0;
+    vector<char> buff(v.size());
+
+    thread t([&]() {
+        {
+            unique_lock<mutex> lock(m);
+            cv.wait(lock, [&] { return canRead; });
+        }
+        
+        while(received < v.size())
+        {
+            auto res = recv(m_clientFd, &buff[received], v.size() - received, 0);
+            if(res <= 0)
+                break;
+            received += res;
+        }
+    });
+    
+    SimpleBuffer<char> buffer(make_shared<MemoryPool>(8, pageSize));
+    buffer.append(v.data(), v.size());
+    
+    auto sent = buffer.spliceTo(*m_bfSocket);
+    ASSERT_EQ(v.size(), sent);
+    ASSERT_EQ(0u, buffer.size());
+    
+    // Send other data from the same buffer, so spliceTo() gets to release the pages of the
+    // first round, then overwrite whatever pages the pool hands out next
+    vector<char> other(v.size(), '#');
+    buffer.append(other.data(), other.size());
+    buffer.spliceTo(*m_bfSocket);
+    buffer.append(other.data(), other.size());
+    buffer.append(other.data(), other.size());
+    
+    {
+        lock_guard<mutex> lock(m);
+        canRead = true;
+    }
+    cv.notify_one();
+    t.join();
+
+    ASSERT_EQ(v.size(), received);
+    ASSERT_EQ(0, memcmp(buff.data(), v.data(), v.size()));
+}
+
 TEST_F(BFTCPSocketTest, TestTCPSocketRead)
 {
     stringstream ss;
@@ -9,6 +9,7 @@
  */
 
 #include "log.h"
+#include "bf.h"
 
 namespace bitforge
 {
@@ -70,9 +71,14 @@ std::ostream& Log::Get(Log::LogLevel level)
 {
     if (!s_useSysLog)
     {
-        namespace pt = boost::posix_time;
-        (*m_os) << "- " << pt::to_iso_string(pt::second_clock::local_time()) << " ";
-        
+        // "- YYYYMMDDTHHMMSS ", local time
+        static TimestampCache s_logTime(TimestampCache::tzLocal, 0, 'T', 0);
+
+        char prefix[32] = "- ";
+        char* c = s_logTime.format(prefix + 2);
+        *c++ = ' ';
+        m_os->write(prefix, c - prefix);
+
         switch(level)
         {
             case logERROR: (*m_os)      << "ERROR   :"; break;
@@ -17,8 +17,6 @@
 #include <sstream>
 #include <iostream>
 
-#include <boost/date_time/posix_time/posix_time.hpp>
-
 #ifndef NDEBUG
 #define log_do(STR, LEVEL) do { if (LEVEL > ::bitforge::Log::ReportingLevel) ; else ::bitforge::Log().Get(LEVEL) << basename(const_cast<char*>(__FILE__)) << ':' << __LINE__ << ": " << STR; } while(false)
 #else
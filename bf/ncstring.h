@@ -11,35 +11,251 @@
 #ifndef __INCLUDE_LIBBF_RAWSTRING_H_
 #define __INCLUDE_LIBBF_RAWSTRING_H_
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <cstring>
 #include <memory>
+#include <new>
 #include <ostream>
 
+#include <bf/stringview.h>
+#include <bf/strsearch.h>
+
 namespace bitforge
 {
 
+const uint64_t FnvOffsetBasis = 0xcbf29ce484222325ull;
+const uint64_t FnvPrime = 0x100000001b3ull;
+
+// 64 bit FNV-1a, the hash used for NCStrings
+inline std::size_t stringHash(const char* data, std::size_t length)
+{
+    uint64_t hash = FnvOffsetBasis;
+
+    for (std::size_t i = 0; i < length; i++)
+    {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= FnvPrime;
+    }
+
+    return hash;
+}
+
+/**
+ * Describes how BasicNCString holds a memory object @T: the reference type shared between
+ * string copies, how a new object of a given size is created and, optionally, where the
+ * hash of the string it holds is cached.
+ * The default keeps the object in a std::shared_ptr and caches nothing.
+ */
+template<typename T>
+struct MemoryObjectTraits
+{
+    typedef std::shared_ptr<T> Ref;
+
+    static Ref alloc(std::size_t size) { return std::make_shared<T>(size); }
+
+    static void contentChanged(const Ref&, std::size_t) {}
+    static bool cachedHash(const Ref&, std::size_t, std::size_t&) { return false; }
+    static void cacheHash(const Ref&, std::size_t, std::size_t) {}
+};
+
 /**
  * @class NSString - No-copy string
  * @description Thread-safe string that breaks std::string COW's problems
+ * Strings up to InlineCapacity chars are stored inside the object itself and never
+ * touch the heap; longer ones share a reference counted buffer between copies.
+ * substr() of a long string is a view into the same buffer. Such a view is only NUL
+ * terminated (by taking its own copy) when c_str() is called, so concurrent c_str()
+ * calls on the very same object are not safe; copies are independent as usual.
  */
 
 template<typename T>
 class BasicNCString
 {
+public:
+    static const std::size_t InlineCapacity = 22;
+
 private:
-    typedef std::shared_ptr<T> CharRef;
+    typedef MemoryObjectTraits<T> Traits;
+    typedef typename Traits::Ref CharRef;
+
+    // Mutable so c_str() can NUL terminate views
+    mutable CharRef     m_memory;
+    mutable char*       m_begin = nullptr;
+    std::size_t         m_length = 0;
+    mutable std::size_t m_maxSize = 0;
+    mutable char        m_inline[InlineCapacity + 1];
+
+    bool isInline() const
+    {
+        return m_begin == m_inline;
+    }
+
+    bool isUnique() const
+    {
+        return isInline() || m_memory.use_count() == 1;
+    }
+
+    void alloc(std::size_t size) const
+    {
+        if (size <= InlineCapacity + 1)
+        {
+            m_maxSize = InlineCapacity + 1;
+            m_memory.reset();
+            m_begin = m_inline;
+        }
+        else
+        {
+            m_maxSize = size;
+            m_memory = Traits::alloc(size);
+            m_begin = m_memory->get();
+        }
+    }
+
+    // A string pointing to memory it doesn't own, see unowned()
+    bool isUnowned() const
+    {
+        return m_begin && !m_memory && !isInline();
+    }
+
+    // Must be called after the contents of an exclusively owned buffer were written
+    void written() const
+    {
+        if (m_memory)
+            Traits::contentChanged(m_memory, m_length);
+    }
+
+    void assignBytes(const char* str, std::size_t length)
+    {
+        // @str may point into our own buffer
+        CharRef oldRef = m_memory;
+
+        m_length = length;
+        alloc(m_length + 1);
+        memmove(m_begin, str, m_length);
+        m_begin[m_length] = 0;
+        written();
+    }
+
+    void copyFrom(const BasicNCString& other)
+    {
+        if (other.isUnowned())
+        {
+            assignBytes(other.m_begin, other.m_length);
+            return;
+        }
+
+        m_length = other.m_length;
+        m_maxSize = other.m_maxSize;
+
+        if (other.isInline())
+        {
+            m_memory.reset();
+            memcpy(m_inline, other.m_inline, m_length + 1);
+            m_begin = m_inline;
+        }
+        else
+        {
+            m_memory = other.m_memory;
+            m_begin = other.m_begin;
+        }
+    }
+
+    // View sharing @other's buffer, @start + @length must be within @other
+    BasicNCString(const BasicNCString& other, std::size_t start, std::size_t length)
+    {
+        m_length = length;
+
+        if (length <= InlineCapacity)
+        {
+            memcpy(m_inline, other.m_begin + start, length);
+            m_inline[length] = 0;
+            m_begin = m_inline;
+            m_maxSize = InlineCapacity + 1;
+        }
+        else
+        {
+            m_memory = other.m_memory;
+            m_begin = other.m_begin + start;
+            m_maxSize = other.m_maxSize - start;
+        }
+    }
+
+    // Moves the contents to a new exclusively owned buffer of @size bytes
+    void reallocate(std::size_t size)
+    {
+        CharRef oldRef = m_memory;
+        const char* oldBegin = m_begin;
+
+        alloc(size);
+        if (m_length)
+            memmove(m_begin, oldBegin, m_length);
+        m_begin[m_length] = 0;
+        written();
+    }
+
+    // Room for @length chars past the end, growing geometrically; followed by appended()
+    char* appendSpace(std::size_t length)
+    {
+        const std::size_t newLength = m_length + length;
+        if (!isUnique() || newLength >= m_maxSize)
+            reallocate(std::max(newLength + 1, m_length * 2));
+        return m_begin + m_length;
+    }
 
-    CharRef         m_memory;
-    char*           m_begin = nullptr;
-    std::size_t     m_length = 0;
-    std::size_t     m_maxSize = 0;
+    void appended(std::size_t length)
+    {
+        m_length += length;
+        m_begin[m_length] = 0;
+        written();
+    }
+
+    template<typename> friend class BasicNCStringBuilder;
+
+    // Below this many chars a plain loop beats a call into the vector code
+    static const std::ptrdiff_t SearchVectorSize = 16;
 
-    void alloc(std::size_t size)
+    std::size_t position(const char* match) const
     {
-        m_maxSize = size;
-        m_memory = std::make_shared<T>(size);
-        m_begin = m_memory->get();
+        return match ? match - m_begin : npos;
+    }
+
+    static int compareBytes(const char* a, std::size_t aLen, const char* b, std::size_t bLen)
+    {
+        const int res = memcmp(a, b, std::min(aLen, bLen));
+        if (res != 0)
+            return res;
+        return aLen < bLen ? -1 : (aLen > bLen ? 1 : 0);
+    }
+
+    void moveFrom(BasicNCString& other)
+    {
+        if (other.isUnowned())
+        {
+            assignBytes(other.m_begin, other.m_length);
+            return;
+        }
+
+        m_length = other.m_length;
+        m_maxSize = other.m_maxSize;
+
+        if (other.isInline())
+        {
+            m_memory.reset();
+            memcpy(m_inline, other.m_inline, m_length + 1);
+            m_begin = m_inline;
+        }
+        else
+        {
+            m_memory = std::move(other.m_memory);
+            m_begin = other.m_begin;
+        }
+
+        other.m_begin = nullptr;
+        other.m_length = 0;
+        other.m_maxSize = 0;
     }
 
 public:
@@ -49,50 +265,38 @@ public:
 
     BasicNCString(const BasicNCString& other)
     {
-        m_length = other.m_length;
-        m_memory = other.m_memory;
-        m_begin = m_memory ? m_memory->get() : nullptr;
+        copyFrom(other);
     }
 
     BasicNCString& operator=(const BasicNCString& other)
     {
-        m_length = other.m_length;
-        m_memory = other.m_memory;
-        m_begin = m_memory ? m_memory->get() : nullptr;
+        if (this != &other)
+            copyFrom(other);
 
         return *this;
     }
 
     BasicNCString(BasicNCString&& other)
     {
-        std::swap(m_memory, other.m_memory);
-        std::swap(m_begin, other.m_begin);
-        std::swap(m_length, other.m_length);
+        moveFrom(other);
     }
 
     BasicNCString& operator=(BasicNCString&& other)
     {
-        std::swap(m_memory, other.m_memory);
-        std::swap(m_begin, other.m_begin);
-        std::swap(m_length, other.m_length);
+        if (this != &other)
+            moveFrom(other);
+
         return *this;
     }
 
     BasicNCString(const std::string &str)
     {
-        m_length = str.length();
-        alloc(m_length + 1);
-        memcpy(m_begin, str.c_str(), m_length);
-        m_begin[m_length] = 0;
+        assignBytes(str.data(), str.length());
     }
 
     BasicNCString& operator=(const std::string &str)
     {
-        m_length = str.length();
-        alloc(m_length + 1);
-        memcpy(m_begin, str.c_str(), m_length);
-        m_begin[m_length] = 0;
-
+        assignBytes(str.data(), str.length());
         return *this;
     }
 
@@ -103,12 +307,37 @@ public:
         return std::string();
     }
 
+    explicit BasicNCString(StringView str)
+    {
+        assignBytes(str.data(), str.size());
+    }
+
+    operator StringView() const
+    {
+        return StringView(m_begin, m_length);
+    }
+
+    StringView view() const
+    {
+        return StringView(m_begin, m_length);
+    }
+
+    /**
+     * String referring to @length bytes at @str without copying them, meant for lookups
+     * (i.e. map.find(NCString::unowned(buffer, len))) that should not allocate.
+     * The caller must keep @str alive while it is in use; copies and moves of it own their memory.
+     */
+    static BasicNCString unowned(const char* str, std::size_t length)
+    {
+        BasicNCString result;
+        result.m_begin = const_cast<char*>(str);
+        result.m_length = length;
+        return result;
+    }
+
     BasicNCString(const char* str)
     {
-        m_length = strlen(str);
-        alloc(m_length + 1);
-        memcpy(m_begin, str, m_length);
-        m_begin[m_length] = 0;
+        assignBytes(str, strlen(str));
     }
 
     BasicNCString& operator=(const char* str)
@@ -124,18 +353,12 @@ public:
 
     void assign(const char* str, std::size_t len)
     {
-        m_length = len;
-        alloc(m_length + 1);
-        memcpy(m_begin, str, m_length);
-        m_begin[m_length] = 0;
+        assignBytes(str, len);
     }
 
-    BasicNCString(const char* str, std::size_t length) :
-        m_length(length)
+    BasicNCString(const char* str, std::size_t length)
     {
-        alloc(m_length + 1);
-        memcpy(m_begin, str, m_length);
-        m_begin[m_length] = 0;
+        assignBytes(str, length);
     }
 
     bool operator<(const BasicNCString& other) const
@@ -147,17 +370,17 @@ public:
         else if (o == nullptr)
             return false;
         else
-            return std::strcmp(t, o) < 0;
+            return compareBytes(t, m_length, o, other.m_length) < 0;
     }
 
     bool operator==(const BasicNCString& other) const
     {
-        return std::strncmp(begin(), other.begin(), m_length) == 0;
+        return m_length == other.m_length && (m_length == 0 || std::memcmp(m_begin, other.m_begin, m_length) == 0);
     }
 
     bool operator!=(const BasicNCString& other) const
     {
-        return std::strncmp(begin(), other.begin(), m_length) != 0;
+        return !(*this == other);
     }
     
     char& operator[](std::size_t pos)
@@ -176,33 +399,51 @@ public:
             return m_begin[m_length];
     }
 
-    void append(const char* str)
+    void append(const char* str, std::size_t length)
     {
-        const auto strLen = strlen(str);
-        const auto newLen = m_length + strLen;
-
-        if (m_memory.use_count() == 1 && newLen < m_maxSize)
-        {
-            char *c = m_begin + m_length;
-            memcpy(c, str, strLen);
-        }
+        if (isUnique() && m_length + length < m_maxSize)
+            memcpy(m_begin + m_length, str, length);
         else
         {
-            CharRef oldStr = m_memory;
-            const char *oldBegin = m_begin;
-            alloc(newLen + 1);
-
-            memcpy(m_begin, oldBegin, m_length);
-            memcpy(m_begin + m_length, str, strLen);
+            CharRef oldRef = m_memory; // @str may point into our own buffer
+            memcpy(appendSpace(length), str, length);
         }
 
-        m_length = newLen;
-        m_begin[m_length] = 0;
+        appended(length);
+    }
+
+    void append(const char* str)
+    {
+        append(str, strlen(str));
     }
 
     void append(const std::string& str)
     {
-        append(str.c_str());
+        append(str.data(), str.size());
+    }
+
+    void append(const BasicNCString& str)
+    {
+        append(str.m_begin, str.m_length);
+    }
+
+    void append(char c)
+    {
+        *appendSpace(1) = c;
+        appended(1);
+    }
+
+    // Chars that can be appended without reallocating
+    std::size_t capacity() const
+    {
+        return isUnique() && m_maxSize ? m_maxSize - 1 : 0;
+    }
+
+    // Makes sure @capacity chars fit in an exclusively owned buffer
+    void reserve(std::size_t capacity)
+    {
+        if (!isUnique() || capacity >= m_maxSize)
+            reallocate(std::max(capacity, m_length) + 1);
     }
 
     BasicNCString& operator+=(const char* str)
@@ -222,11 +463,54 @@ public:
         return m_begin;
     }
 
+    /**
+     * NUL terminated string. Views (see substr()) that end before their buffer does
+     * are copied here, data() never copies but is not guaranteed to be terminated.
+     */
     const char* c_str() const
     {
+        if (isUnowned() || (m_begin && m_begin[m_length] != 0))
+        {
+            if (m_memory && isUnique())
+            {
+                // Nobody else sees the rest of the buffer
+                m_begin[m_length] = 0;
+            }
+            else
+            {
+                CharRef oldRef = m_memory;
+                const char* oldBegin = m_begin;
+
+                alloc(m_length + 1);
+                memcpy(m_begin, oldBegin, m_length);
+                m_begin[m_length] = 0;
+                written();
+            }
+        }
+
         return data();
     }
 
+    /**
+     * stringHash() of the contents. Strings in a SharedMemoryBlock cache it in the block
+     * header, so copies only compute it once.
+     */
+    std::size_t hash() const
+    {
+        if (m_memory && m_begin == m_memory->get())
+        {
+            std::size_t result;
+            if (!Traits::cachedHash(m_memory, m_length, result))
+            {
+                result = stringHash(m_begin, m_length);
+                Traits::cacheHash(m_memory, m_length, result);
+            }
+            return result;
+        }
+
+        return stringHash(m_begin, m_length);
+    }
+
     const char* begin() const
     {
         return data();
@@ -247,6 +531,7 @@ public:
         m_memory.reset();
         m_begin = nullptr;
         m_length = 0;
+        m_maxSize = 0;
     }
 
     bool empty() const
@@ -256,44 +541,113 @@ public:
 
     int compare(const char* other) const
     {
-        return std::strcmp(m_begin, other);
+        return compareBytes(m_begin, m_length, other, strlen(other));
     }
 
     int compare(const BasicNCString& other) const
     {
-        return std::strcmp(m_begin, other.m_begin);
+        return compareBytes(m_begin, m_length, other.m_begin, other.m_length);
     }
 
-    std::size_t find(char v) const
+    // Searches longer than a vector go through the SIMD routines in strsearch.h
+    std::size_t find(char v, std::size_t pos = 0) const
     {
-        std::size_t res = 0;
-        const char* c = m_begin;
+        if (pos >= m_length)
+            return npos;
+
+        const char* c = m_begin + pos;
         const char* e = m_begin + m_length;
 
-        for(; c != e; c++, res++)
+        if (e - c >= SearchVectorSize)
+            return position(findChar(c, e - c, v));
+
+        for(; c != e; c++)
             if (*c == v)
-                return res;
+                return c - m_begin;
+
+        return npos;
+    }
+
+    std::size_t find(const char* v, std::size_t pos, std::size_t length) const
+    {
+        if (pos > m_length)
+            return npos;
+        if (length == 0)
+            return pos;
+        return position(findString(m_begin + pos, m_length - pos, v, length));
+    }
+
+    std::size_t find(const char* v, std::size_t pos = 0) const
+    {
+        return find(v, pos, strlen(v));
+    }
+
+    std::size_t find(const BasicNCString& v, std::size_t pos = 0) const
+    {
+        return find(v.m_begin, pos, v.m_length);
+    }
+
+    // Last match starting at or before @pos
+    std::size_t rfind(char v, std::size_t pos = npos) const
+    {
+        if (m_length == 0)
+            return npos;
+        return position(findCharReverse(m_begin, std::min(pos, m_length - 1) + 1, v));
+    }
+
+    std::size_t rfind(const char* v, std::size_t pos, std::size_t length) const
+    {
+        if (length > m_length)
+            return npos;
+        if (length == 0)
+            return std::min(pos, m_length);
+        return position(findStringReverse(m_begin, std::min(pos, m_length - length) + length, v, length));
+    }
+
+    std::size_t rfind(const char* v, std::size_t pos = npos) const
+    {
+        return rfind(v, pos, strlen(v));
+    }
+
+    std::size_t rfind(const BasicNCString& v, std::size_t pos = npos) const
+    {
+        return rfind(v.m_begin, pos, v.m_length);
+    }
+
+    std::size_t find_first_of(const char* set, std::size_t pos = 0) const
+    {
+        if (pos >= m_length)
+            return npos;
+        return position(findFirstOf(m_begin + pos, m_length - pos, set, strlen(set)));
+    }
 
-        return std::string::npos;
+    std::size_t find_first_of(const BasicNCString& set, std::size_t pos = 0) const
+    {
+        if (pos >= m_length)
+            return npos;
+        return position(findFirstOf(m_begin + pos, m_length - pos, set.m_begin, set.m_length));
     }
 
+    // Substrings share this string's buffer, see c_str()
     BasicNCString substr(std::size_t start) const
     {
-        std::size_t l = m_length - start;
-        return BasicNCString(m_begin + start, l);
+        if (start >= m_length)
+            return BasicNCString("", 0);
+        return BasicNCString(*this, start, m_length - start);
     }
 
     BasicNCString substr(std::size_t start, std::size_t length) const
     {
-        std::size_t l = std::min(length, m_length - start);
-        return BasicNCString(m_begin + start, l);
+        if (start >= m_length)
+            return BasicNCString("", 0);
+        return BasicNCString(*this, start, std::min(length, m_length - start));
     }
 
     void chop(std::size_t length)
     {
         if (m_length && length < m_length)
         {
-            if (m_memory.use_count() == 1)
+            if (isUnique())
             {
                 const_cast<char*>(m_begin)[length] = 0;
                 m_length = length;
@@ -310,10 +664,15 @@ public:
 
                 m_begin[m_length] = 0;
             }
+
+            written();
         }
     }
 };
 
+template<typename T>
+const std::size_t BasicNCString<T>::InlineCapacity;
+
 template<typename T>
 std::ostream& operator<<(std::ostream& stream, const BasicNCString<T>& string)
 {
@@ -342,9 +701,242 @@ public:
     char* get() { return m_memory; }
 };
 
-typedef BasicNCString<BasicMemoryObject> NCString;
+/**
+ * Reference counting policies for SharedMemoryBlock.
+ * AtomicRefCount is safe to share between threads, NonAtomicRefCount uses plain
+ * increments and is meant for thread-confined strings.
+ */
+struct AtomicRefCount
+{
+    typedef std::atomic<std::size_t> Counter;
+
+    static void increment(Counter& c) { c.fetch_add(1, std::memory_order_relaxed); }
+    static bool decrement(Counter& c) { return c.fetch_sub(1, std::memory_order_acq_rel) == 1; }
+    static std::size_t get(const Counter& c) { return c.load(std::memory_order_relaxed); }
+    static void set(Counter& c, std::size_t v) { c.store(v, std::memory_order_relaxed); }
+};
+
+struct NonAtomicRefCount
+{
+    typedef std::size_t Counter;
+
+    static void increment(Counter& c) { ++c; }
+    static bool decrement(Counter& c) { return --c == 0; }
+    static std::size_t get(const Counter& c) { return c; }
+    static void set(Counter& c, std::size_t v) { c = v; }
+};
+
+/**
+ * Where a SharedMemoryBlock's memory comes from. The block derives from its storage policy,
+ * which may keep per-block state; freeOnRelease() tells whether the memory is given back
+ * with deallocate() once the last reference is gone.
+ */
+class HeapBlockStorage
+{
+protected:
+    static void* allocate(std::size_t size, std::size_t) { return ::operator new(size); }
+    static void deallocate(void* memory) { ::operator delete(memory); }
+    bool freeOnRelease() const { return true; }
+};
+
+/**
+ * Memory object whose header (reference count, capacity, cached hash) and characters share
+ * a single allocation, on the heap by default. Lifetime is managed intrusively by MemoryBlockRef.
+ */
+template<typename RefCountPolicy, typename Storage = HeapBlockStorage>
+class SharedMemoryBlock: public Storage
+{
+private:
+    typename RefCountPolicy::Counter    m_refCount;
+    typename RefCountPolicy::Counter    m_hash;         // 0 when not computed
+    const std::size_t                   m_capacity;
+    std::size_t                         m_length = 0;   // Length of the string written by the owner
+
+    SharedMemoryBlock(std::size_t capacity): m_refCount(1), m_hash(0), m_capacity(capacity) {}
+    ~SharedMemoryBlock() {}
+
+public:
+    SharedMemoryBlock(const SharedMemoryBlock&) = delete;
+    void operator=(const SharedMemoryBlock&) = delete;
+
+    static SharedMemoryBlock* create(std::size_t size)
+    {
+        void* memory = Storage::allocate(sizeof(SharedMemoryBlock) + size, alignof(SharedMemoryBlock));
+        return new (memory) SharedMemoryBlock(size);
+    }
+
+    void addRef() { RefCountPolicy::increment(m_refCount); }
+
+    void release()
+    {
+        if (RefCountPolicy::decrement(m_refCount))
+        {
+            const bool freeMemory = this->freeOnRelease();
+            this->~SharedMemoryBlock();
+            if (freeMemory)
+                Storage::deallocate(this);
+        }
+    }
+
+    std::size_t useCount() const { return RefCountPolicy::get(m_refCount); }
+    std::size_t capacity() const { return m_capacity; }
+
+    // Only called by an exclusive owner, so there are no concurrent readers
+    void contentChanged(std::size_t length)
+    {
+        m_length = length;
+        RefCountPolicy::set(m_hash, 0);
+    }
+
+    // The cache is only valid for the whole string, not for views on part of it
+    bool cachedHash(std::size_t length, std::size_t& hash) const
+    {
+        if (length != m_length)
+            return false;
+        hash = RefCountPolicy::get(m_hash);
+        return hash != 0;
+    }
+
+    void cacheHash(std::size_t length, std::size_t hash)
+    {
+        if (length == m_length)
+            RefCountPolicy::set(m_hash, hash);
+    }
+
+    char* get() { return reinterpret_cast<char*>(this + 1); }
+};
+
+/**
+ * Intrusive reference to a block exposing addRef()/release()/useCount().
+ * Adopts the initial reference of the block it is constructed with.
+ */
+template<typename B>
+class MemoryBlockRef
+{
+private:
+    B* m_block = nullptr;
+
+public:
+    MemoryBlockRef() {}
+    explicit MemoryBlockRef(B* block): m_block(block) {}
+
+    MemoryBlockRef(const MemoryBlockRef& other): m_block(other.m_block)
+    {
+        if (m_block)
+            m_block->addRef();
+    }
+
+    MemoryBlockRef(MemoryBlockRef&& other): m_block(other.m_block)
+    {
+        other.m_block = nullptr;
+    }
+
+    ~MemoryBlockRef()
+    {
+        if (m_block)
+            m_block->release();
+    }
+
+    MemoryBlockRef& operator=(const MemoryBlockRef& other)
+    {
+        if (other.m_block)
+            other.m_block->addRef();
+        if (m_block)
+            m_block->release();
+        m_block = other.m_block;
+        return *this;
+    }
+
+    MemoryBlockRef& operator=(MemoryBlockRef&& other)
+    {
+        if (this != &other)
+        {
+            if (m_block)
+                m_block->release();
+            m_block = other.m_block;
+            other.m_block = nullptr;
+        }
+        return *this;
+    }
+
+    void reset()
+    {
+        if (m_block)
+            m_block->release();
+        m_block = nullptr;
+    }
+
+    long use_count() const { return m_block ? m_block->useCount() : 0; }
+
+    B* get() const { return m_block; }
+    B* operator->() const { return m_block; }
+    explicit operator bool() const { return m_block != nullptr; }
+};
+
+template<typename RefCountPolicy, typename Storage>
+struct MemoryObjectTraits<SharedMemoryBlock<RefCountPolicy, Storage>>
+{
+    typedef MemoryBlockRef<SharedMemoryBlock<RefCountPolicy, Storage>> Ref;
+
+    static Ref alloc(std::size_t size) { return Ref(SharedMemoryBlock<RefCountPolicy, Storage>::create(size)); }
+
+    static void contentChanged(const Ref& ref, std::size_t length) { ref->contentChanged(length); }
+    static bool cachedHash(const Ref& ref, std::size_t length, std::size_t& hash) { return ref->cachedHash(length, hash); }
+    static void cacheHash(const Ref& ref, std::size_t length, std::size_t hash) { ref->cacheHash(length, hash); }
+};
+
+// Thread-safe string, a single allocation per (long) string
+typedef BasicNCString<SharedMemoryBlock<AtomicRefCount>> NCString;
+
+// String that must not be shared between threads; copies do no atomic operations
+typedef BasicNCString<SharedMemoryBlock<NonAtomicRefCount>> LocalNCString;
+
+/**
+ * Transparent hash/equality for unordered containers keyed by NCStrings.
+ * With C++20 containers, find() accepts a const char* or StringView directly; otherwise look
+ * keys up with NCString::unowned() to avoid materializing a string.
+ */
+struct NCStringHash
+{
+    typedef void is_transparent;
+
+    template<typename T>
+    std::size_t operator()(const BasicNCString<T>& str) const { return str.hash(); }
+    std::size_t operator()(StringView str) const { return stringHash(str.data(), str.size()); }
+    std::size_t operator()(const char* str) const { return stringHash(str, strlen(str)); }
+};
+
+struct NCStringEqual
+{
+    typedef void is_transparent;
+
+    static StringView view(StringView str) { return str; }
+    static StringView view(const char* str) { return StringView(str, strlen(str)); }
+
+    template<typename T>
+    static StringView view(const BasicNCString<T>& str) { return str.view(); }
+
+    template<typename A, typename B>
+    bool operator()(const A& a, const B& b) const
+    {
+        const StringView va = view(a);
+        const StringView vb = view(b);
+        return va.size() == vb.size() && memcmp(va.data(), vb.data(), va.size()) == 0;
+    }
+};
 
 } // bitforge
 
+namespace std
+{
+
+template<typename T>
+struct hash<bitforge::BasicNCString<T>>
+{
+    std::size_t operator()(const bitforge::BasicNCString<T>& str) const { return str.hash(); }
+};
+
+} // std
+
 #endif // __INCLUDE_LIBBF_RAWSTRING_H_
 
@@ -0,0 +1,129 @@
+/*
+ * ncstringbuilder.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: gianni
+ *
+ * BitForge http://www.bitforge.com.br
+ * Copyright (c) 2012 All Right Reserved,
+ */
+
+#ifndef __INCLUDE_LIBBF_NCSTRINGBUILDER_H_
+#define __INCLUDE_LIBBF_NCSTRINGBUILDER_H_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <bf/ncstring.h>
+#include <bf/inthex.h>
+
+namespace bitforge
+{
+
+/**
+ * @class BasicNCStringBuilder
+ * @description Builds an NCString piece by piece. The buffer grows geometrically and
+ * numbers are formatted straight into it, so a line costs a handful of allocations at most
+ * (none with a big enough reserve()) and never a temporary std::string.
+ *
+ *   NCStringBuilder b(64);
+ *   b << "Content-Length: " << size << "\r\n";
+ *   NCString header = b.release();
+ */
+template<typename T>
+class BasicNCStringBuilder
+{
+private:
+    BasicNCString<T> m_string;
+
+public:
+    explicit BasicNCStringBuilder(std::size_t capacity = 0)
+    {
+        if (capacity)
+            m_string.reserve(capacity);
+    }
+
+    void reserve(std::size_t capacity) { m_string.reserve(capacity); }
+    std::size_t length() const { return m_string.length(); }
+    std::size_t capacity() const { return m_string.capacity(); }
+
+    void clear()
+    {
+        // Keeps the buffer when nobody else shares it
+        if (m_string.isUnique() && m_string.m_length)
+        {
+            m_string.m_length = 0;
+            m_string.appended(0);
+        }
+        else
+            m_string.clear();
+    }
+
+    const BasicNCString<T>& str() const { return m_string; }
+
+    // Hands the string over, leaving the builder empty
+    BasicNCString<T> release() { return std::move(m_string); }
+
+    BasicNCStringBuilder& append(const char* str, std::size_t length)
+    {
+        m_string.append(str, length);
+        return *this;
+    }
+
+    BasicNCStringBuilder& append(const char* str) { return append(str, strlen(str)); }
+    BasicNCStringBuilder& append(const std::string& str) { return append(str.data(), str.size()); }
+    BasicNCStringBuilder& append(const BasicNCString<T>& str) { return append(str.data(), str.length()); }
+
+    BasicNCStringBuilder& append(char c)
+    {
+        m_string.append(c);
+        return *this;
+    }
+
+    BasicNCStringBuilder& appendUInt(uint64_t val)
+    {
+        m_string.appended(u64toa(m_string.appendSpace(20), val));
+        return *this;
+    }
+
+    BasicNCStringBuilder& appendInt(int64_t val)
+    {
+        m_string.appended(i64toa(m_string.appendSpace(20), val));
+        return *this;
+    }
+
+    // Upper case hex, zero padded to at least @width digits
+    BasicNCStringBuilder& appendHex(uint64_t val, std::size_t width = 0)
+    {
+        // uint64tohex() writes right aligned and NUL terminated
+        const int bufferSize = 17;
+        char* buffer = m_string.appendSpace(bufferSize + width);
+        const char* digits = uint64tohex(buffer + width, bufferSize, val);
+        const std::size_t length = (buffer + width + bufferSize - 1) - digits;
+
+        std::size_t pad = width > length ? width - length : 0;
+        memset(buffer, '0', pad);
+        memmove(buffer + pad, digits, length);
+        m_string.appended(pad + length);
+        return *this;
+    }
+
+    BasicNCStringBuilder& operator<<(const char* str) { return append(str); }
+    BasicNCStringBuilder& operator<<(const std::string& str) { return append(str); }
+    BasicNCStringBuilder& operator<<(const BasicNCString<T>& str) { return append(str); }
+    BasicNCStringBuilder& operator<<(char c) { return append(c); }
+    BasicNCStringBuilder& operator<<(int val) { return appendInt(val); }
+    BasicNCStringBuilder& operator<<(long val) { return appendInt(val); }
+    BasicNCStringBuilder& operator<<(long long val) { return appendInt(val); }
+    BasicNCStringBuilder& operator<<(unsigned int val) { return appendUInt(val); }
+    BasicNCStringBuilder& operator<<(unsigned long val) { return appendUInt(val); }
+    BasicNCStringBuilder& operator<<(unsigned long long val) { return appendUInt(val); }
+};
+
+typedef BasicNCStringBuilder<SharedMemoryBlock<AtomicRefCount>> NCStringBuilder;
+typedef BasicNCStringBuilder<SharedMemoryBlock<NonAtomicRefCount>> LocalNCStringBuilder;
+
+} // bitforge
+
+#endif // __INCLUDE_LIBBF_NCSTRINGBUILDER_H_
@@ -72,7 +72,9 @@ void NCForm::addButtons(NCFormButtonVector buttons)
 
 std::string NCForm::getFieldData(int index)
 {
-    return bitforge::stringStrip(field_buffer(m_ncFields[index], 0));
+    // Field buffers are padded with spaces to the field's width
+    const bitforge::StringView data = bitforge::strip(field_buffer(m_ncFields[index], 0));
+    return std::string(data.data(), data.size());
 }
 
 void NCForm::initialize()
@@ -0,0 +1,380 @@
+/*
+ * process.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: gianni
+ *
+ * BitForge http://www.bitforge.com.br
+ * Copyright (c) 2012 All Right Reserved,
+ */
+
+#include "process.h"
+#include "bf.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/epoll.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+
+namespace bitforge
+{
+
+namespace
+{
+
+ErrnoException processError(const char* what, int error)
+{
+    return ErrnoException(std::string(what) + ": '" + strerror(error) + '\'', error);
+}
+
+void closeFd(int& fd)
+{
+    if (fd >= 0)
+    {
+        close(fd);
+        fd = -1;
+    }
+}
+
+// A pidfd for @pid, -1 where the kernel has none. They are always close-on-exec
+int openPidFd(pid_t pid)
+{
+#ifdef SYS_pidfd_open
+    const long fd = syscall(SYS_pidfd_open, pid, 0);
+    return fd >= 0 ? static_cast<int>(fd) : -1;
+#else
+    (void)pid;
+    return -1;
+#endif
+}
+
+}
+
+pid_t spawnProcess(const char* const args[], const char* const env[], int pipes, int fds[3], bool nonBlocking)
+{
+    int childFds[3] = {-1, -1, -1};
+    std::fill(fds, fds + 3, -1);
+
+    auto closeAll = [&]
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            closeFd(fds[i]);
+            closeFd(childFds[i]);
+        }
+    };
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+
+    for (int i = 0; i < 3; i++)
+    {
+        if (!(pipes & (1 << i)))
+            continue;
+
+        int p[2];
+        if (pipe2(p, O_CLOEXEC) != 0)
+        {
+            const int error = errno;
+            posix_spawn_file_actions_destroy(&actions);
+            closeAll();
+            throw processError("Can't create pipe", error);
+        }
+
+        // The child reads stdin and writes the others
+        fds[i] = i == 0 ? p[1] : p[0];
+        childFds[i] = i == 0 ? p[0] : p[1];
+
+        if (nonBlocking)
+            fcntl(fds[i], F_SETFL, fcntl(fds[i], F_GETFL) | O_NONBLOCK);
+
+        // dup2 clears close-on-exec on the child's copy only
+        posix_spawn_file_actions_adddup2(&actions, childFds[i], i);
+    }
+
+    pid_t pid;
+    const int rc = posix_spawnp(&pid, args[0], &actions, nullptr,
+                                const_cast<char* const*>(args), const_cast<char* const*>(env));
+    posix_spawn_file_actions_destroy(&actions);
+
+    for (int& fd : childFds)
+        closeFd(fd);
+
+    if (rc != 0)
+    {
+        closeAll();
+        throw processError((std::string("Can't start ") + args[0]).c_str(), rc);
+    }
+
+    return pid;
+}
+
+/****************************** Process ******************************/
+
+Process::Process(const char* const args[], const char* const env[], int pipes):
+    m_pid(-1),
+    m_pidFd(-1),
+    m_status(0),
+    m_exited(false),
+    m_monitor(nullptr)
+{
+    int fds[3];
+    m_pid = spawnProcess(args, env, pipes, fds, true);
+
+    m_stdIn = fds[0];
+    m_stdOut = fds[1];
+    m_stdErr = fds[2];
+
+    // The pid can't be reused before we reap it, so opening it late is safe
+    m_pidFd = openPidFd(m_pid);
+}
+
+Process::~Process()
+{
+    if (m_monitor)
+        m_monitor->remove(this);
+
+    closeFd(m_stdIn);
+    closeFd(m_stdOut);
+    closeFd(m_stdErr);
+
+    if (!m_exited)
+    {
+        ::kill(m_pid, SIGKILL);
+        while (waitpid(m_pid, &m_status, 0) < 0 && errno == EINTR);
+    }
+
+    closeFd(m_pidFd);
+}
+
+void Process::closeFd(int& fd)
+{
+    if (fd >= 0 && m_monitor)
+        epoll_ctl(m_monitor->fileDescriptor(), EPOLL_CTL_DEL, fd, nullptr);
+
+    bitforge::closeFd(fd);
+}
+
+void Process::closeStdIn()
+{
+    closeFd(m_stdIn);
+}
+
+bool Process::drain(int& fd, std::string& out)
+{
+    char buffer[4096];
+
+    while (fd >= 0)
+    {
+        const ssize_t r = read(fd, buffer, sizeof(buffer));
+        if (r > 0)
+            out.append(buffer, r);
+        else if (r == 0)
+            closeFd(fd);
+        else if (errno == EAGAIN || errno == EWOULDBLOCK)
+            return true;
+        else if (errno != EINTR)
+        {
+            const int error = errno;
+            closeFd(fd);
+            throw processError("Error reading process output", error);
+        }
+    }
+
+    return false;
+}
+
+bool Process::collect()
+{
+    const bool outOpen = drain(m_stdOut, m_output);
+    const bool errOpen = drain(m_stdErr, m_errors);
+    return outOpen || errOpen;
+}
+
+std::string Process::takeOutput()
+{
+    std::string ret;
+    ret.swap(m_output);
+    return ret;
+}
+
+std::string Process::takeErrors()
+{
+    std::string ret;
+    ret.swap(m_errors);
+    return ret;
+}
+
+bool Process::poll()
+{
+    if (m_exited)
+        return true;
+
+    pid_t rc;
+    while ((rc = waitpid(m_pid, &m_status, WNOHANG)) < 0 && errno == EINTR);
+
+    if (rc == m_pid)
+    {
+        m_exited = true;
+
+        closeFd(m_pidFd);
+    }
+    else if (rc < 0)
+        throw processError("waitpid", errno);
+
+    return m_exited;
+}
+
+int Process::wait()
+{
+    // Nobody is going to write to it any more
+    closeStdIn();
+
+    while (collect())
+    {
+        struct pollfd fds[2] = { { m_stdOut, POLLIN, 0 }, { m_stdErr, POLLIN, 0 } };
+        if (::poll(fds, 2, -1) < 0 && errno != EINTR)
+            throw processError("poll", errno);
+    }
+
+    if (!m_exited)
+    {
+        while (waitpid(m_pid, &m_status, 0) < 0)
+        {
+            if (errno != EINTR)
+                throw processError("waitpid", errno);
+        }
+
+        m_exited = true;
+        closeFd(m_pidFd);
+    }
+
+    return m_status;
+}
+
+int Process::exitCode() const
+{
+    return WIFEXITED(m_status) ? WEXITSTATUS(m_status) : -1;
+}
+
+void Process::kill(int signal)
+{
+    if (!m_exited && ::kill(m_pid, signal) != 0)
+        throw processError("kill", errno);
+}
+
+/****************************** ProcessMonitor ******************************/
+
+ProcessMonitor::ProcessMonitor():
+    m_epoll(epoll_create1(EPOLL_CLOEXEC))
+{
+    if (m_epoll < 0)
+        throw processError("epoll_create1", errno);
+}
+
+ProcessMonitor::~ProcessMonitor()
+{
+    for (Process* process : m_processes)
+        process->m_monitor = nullptr;
+
+    close(m_epoll);
+}
+
+void ProcessMonitor::add(Process* process)
+{
+    if (process->m_monitor)
+        process->m_monitor->remove(process);
+
+    for (int fd : { process->stdOut(), process->stdErr(), process->pidFd() })
+    {
+        if (fd < 0)
+            continue;
+
+        struct epoll_event event;
+        zero_init(event);
+        event.events = EPOLLIN;
+        event.data.ptr = process;
+
+        if (epoll_ctl(m_epoll, EPOLL_CTL_ADD, fd, &event) != 0)
+        {
+            const int error = errno;
+            unregister(process);
+            throw processError("epoll_ctl", error);
+        }
+    }
+
+    process->m_monitor = this;
+    m_processes.push_back(process);
+}
+
+void ProcessMonitor::unregister(Process* process)
+{
+    for (int fd : { process->stdOut(), process->stdErr(), process->pidFd() })
+    {
+        if (fd >= 0)
+            epoll_ctl(m_epoll, EPOLL_CTL_DEL, fd, nullptr);
+    }
+
+    process->m_monitor = nullptr;
+}
+
+void ProcessMonitor::remove(Process* process)
+{
+    auto it = std::find(m_processes.begin(), m_processes.end(), process);
+    if (it != m_processes.end())
+    {
+        unregister(process);
+        m_processes.erase(it);
+    }
+}
+
+std::size_t ProcessMonitor::wait(int timeoutMs, std::vector<Process*>& exited)
+{
+    // Without a pidfd nothing tells us about the exit, so it has to be checked by polling
+    for (Process* process : m_processes)
+    {
+        if (process->pidFd() < 0 && !process->exited())
+        {
+            timeoutMs = timeoutMs < 0 ? 10 : std::min(timeoutMs, 10);
+            break;
+        }
+    }
+
+    struct epoll_event events[64];
+    const int count = epoll_wait(m_epoll, events, 64, timeoutMs);
+    if (count < 0 && errno != EINTR)
+        throw processError("epoll_wait", errno);
+
+    for (int i = 0; i < count; i++)
+    {
+        Process* process = static_cast<Process*>(events[i].data.ptr);
+        process->collect();
+        process->poll();
+    }
+
+    const std::size_t before = exited.size();
+    auto done = [&](Process* process)
+    {
+        if (process->pidFd() < 0)
+            process->poll();
+
+        if (!process->exited() || process->stdOut() >= 0 || process->stdErr() >= 0)
+            return false;
+
+        unregister(process);
+        exited.push_back(process);
+        return true;
+    };
+    m_processes.erase(std::remove_if(m_processes.begin(), m_processes.end(), done), m_processes.end());
+
+    return exited.size() - before;
+}
+
+} // bitforge
@@ -0,0 +1,171 @@
+/*
+ * process.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: gianni
+ *
+ * BitForge http://www.bitforge.com.br
+ * Copyright (c) 2012 All Right Reserved,
+ */
+
+#ifndef __INCLUDE_LIBBF_PROCESS_H_
+#define __INCLUDE_LIBBF_PROCESS_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace bitforge
+{
+
+class ProcessMonitor;
+
+enum ProcessPipes
+{
+    ppNone      = 0,
+    ppStdIn     = 1,
+    ppStdOut    = 2,
+    ppStdErr    = 4,
+    ppAll       = ppStdIn | ppStdOut | ppStdErr
+};
+
+/**
+ * Starts @args[0] (searched in PATH) with posix_spawn, so nothing of this process is copied,
+ * and returns its pid. @args and @env end with a nullptr.
+ * The streams in @pipes are connected to pipes whose parent ends are written to @fds
+ * (stdin, stdout, stderr; -1 for the others, which are inherited). The parent ends are
+ * close-on-exec, and non-blocking if @nonBlocking.
+ * Throws ErrnoException if the pipes or the process can't be created.
+ */
+pid_t spawnProcess(const char* const args[], const char* const env[], int pipes, int fds[3], bool nonBlocking);
+
+/**
+ * @class Process
+ * @description A child process started with spawnProcess, whose stdout and stderr are
+ * collected without blocking.
+ * pidFd() (a pidfd, where the kernel has them) becomes readable when the child exits, so
+ * the pidfd and the output pipes can all go in an epoll loop; ProcessMonitor does that.
+ *
+ *   const char* const args[] = {"ls", "-l", nullptr};
+ *   Process ls(args);
+ *   int status = ls.wait();
+ *   std::cout << ls.output();
+ *
+ * A process still running when its Process is destroyed is killed and reaped, and taken
+ * out of its ProcessMonitor.
+ */
+class Process
+{
+private:
+    pid_t       m_pid;
+    int         m_stdIn;
+    int         m_stdOut;
+    int         m_stdErr;
+    int         m_pidFd;
+    int         m_status;
+    bool        m_exited;
+    std::string m_output;
+    std::string m_errors;
+
+    // The monitor watching us, if any
+    ProcessMonitor* m_monitor;
+
+    friend class ProcessMonitor;
+
+    // Takes @fd out of the monitor's epoll set before closing it; the registration belongs to
+    // the pipe, not to the fd, so it would outlive close() while the child's children keep the
+    // pipe open
+    void closeFd(int& fd);
+
+    bool drain(int& fd, std::string& out);
+
+public:
+    Process(const char* const args[], const char* const env[] = environ, int pipes = ppAll);
+    ~Process();
+
+    Process(const Process&) = delete;
+    Process& operator=(const Process&) = delete;
+
+    pid_t pid() const { return m_pid; }
+
+    // Parent ends of the pipes, -1 once closed or if not piped
+    int stdIn() const { return m_stdIn; }
+    int stdOut() const { return m_stdOut; }
+    int stdErr() const { return m_stdErr; }
+
+    // Readable when the process exits, -1 if pidfds are not supported
+    int pidFd() const { return m_pidFd; }
+
+    void closeStdIn();
+
+    // Appends whatever stdout and stderr have ready, returns false once both are at EOF
+    bool collect();
+
+    const std::string& output() const { return m_output; }
+    const std::string& errors() const { return m_errors; }
+
+    // Output collected so far, which is then cleared
+    std::string takeOutput();
+    std::string takeErrors();
+
+    // Reaps the process if it has exited, without blocking
+    bool poll();
+
+    // Collects all output until EOF, then reaps the process and returns its status
+    int wait();
+
+    bool exited() const { return m_exited; }
+
+    // waitpid status, only valid once exited()
+    int status() const { return m_status; }
+
+    // Exit code, or -1 if it was killed by a signal; only valid once exited()
+    int exitCode() const;
+
+    void kill(int signal);
+};
+
+/**
+ * @class ProcessMonitor
+ * @description Waits on the output and exit of many processes at once with one epoll
+ * descriptor, which can itself be polled from another loop through fileDescriptor().
+ * Without pidfds exits are polled for every 10ms.
+ * Processes are not owned; one that is destroyed removes itself.
+ */
+class ProcessMonitor
+{
+private:
+    int                     m_epoll;
+    std::vector<Process*>   m_processes;
+
+    void unregister(Process* process);
+
+public:
+    ProcessMonitor();
+    ~ProcessMonitor();
+
+    ProcessMonitor(const ProcessMonitor&) = delete;
+    ProcessMonitor& operator=(const ProcessMonitor&) = delete;
+
+    int fileDescriptor() const { return m_epoll; }
+
+    void add(Process* process);
+    void remove(Process* process);
+
+    // Processes being monitored, the exited ones are removed by wait()
+    std::size_t size() const { return m_processes.size(); }
+
+    /**
+     * Waits up to @timeoutMs (-1 forever) for something to happen, collects the output that
+     * is ready and moves the processes that have exited and finished their output to @exited.
+     * Returns the number of processes that exited.
+     */
+    std::size_t wait(int timeoutMs, std::vector<Process*>& exited);
+};
+
+} // bitforge
+
+#endif // __INCLUDE_LIBBF_PROCESS_H_
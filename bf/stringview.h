@@ -0,0 +1,108 @@
+/*
+ * stringview.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: gianni
+ *
+ * BitForge http://www.bitforge.com.br
+ * Copyright (c) 2012 All Right Reserved,
+ */
+
+#ifndef __INCLUDE_LIBBF_STRINGVIEW_H_
+#define __INCLUDE_LIBBF_STRINGVIEW_H_
+
+#include <cstring>
+#include <string>
+
+#if (__cplusplus >= 201703L)
+#include <string_view>
+#else
+#include <algorithm>
+#include <ostream>
+#endif
+
+namespace bitforge
+{
+
+#if (__cplusplus >= 201703L)
+
+typedef std::string_view StringView;
+
+#else
+
+/**
+ * @class StringView - Non-owning (pointer, length) view on characters
+ * @description The subset of std::string_view used by libbf, for pre C++17 builds.
+ * With C++17 StringView is std::string_view itself.
+ */
+class StringView
+{
+private:
+    const char*     m_data = nullptr;
+    std::size_t     m_size = 0;
+
+public:
+    typedef const char* const_iterator;
+    typedef const char* iterator;
+
+    static const std::size_t npos = std::string::npos;
+
+    StringView() {}
+    StringView(const char* str): m_data(str), m_size(strlen(str)) {}
+    StringView(const char* str, std::size_t size): m_data(str), m_size(size) {}
+    StringView(const std::string& str): m_data(str.data()), m_size(str.size()) {}
+
+    const char* data() const { return m_data; }
+    std::size_t size() const { return m_size; }
+    std::size_t length() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    const char* begin() const { return m_data; }
+    const char* end() const { return m_data + m_size; }
+
+    const char& operator[](std::size_t pos) const { return m_data[pos]; }
+    const char& front() const { return m_data[0]; }
+    const char& back() const { return m_data[m_size - 1]; }
+
+    void remove_prefix(std::size_t n) { m_data += n; m_size -= n; }
+    void remove_suffix(std::size_t n) { m_size -= n; }
+
+    StringView substr(std::size_t pos, std::size_t n = npos) const
+    {
+        if (pos > m_size)
+            pos = m_size;
+        return StringView(m_data + pos, std::min(n, m_size - pos));
+    }
+
+    std::size_t find(char c, std::size_t pos = 0) const
+    {
+        if (pos >= m_size)
+            return npos;
+        const void* res = memchr(m_data + pos, c, m_size - pos);
+        return res ? static_cast<const char*>(res) - m_data : npos;
+    }
+
+    int compare(StringView other) const
+    {
+        const int res = memcmp(m_data, other.m_data, std::min(m_size, other.m_size));
+        if (res != 0)
+            return res;
+        return m_size < other.m_size ? -1 : (m_size > other.m_size ? 1 : 0);
+    }
+
+    bool operator==(StringView other) const { return m_size == other.m_size && memcmp(m_data, other.m_data, m_size) == 0; }
+    bool operator!=(StringView other) const { return !(*this == other); }
+    bool operator<(StringView other) const { return compare(other) < 0; }
+};
+
+inline std::ostream& operator<<(std::ostream& stream, StringView str)
+{
+    stream.write(str.data(), str.size());
+    return stream;
+}
+
+#endif
+
+} // bitforge
+
+#endif // __INCLUDE_LIBBF_STRINGVIEW_H_
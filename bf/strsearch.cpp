@@ -0,0 +1,557 @@
+/*
+ * strsearch.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: gianni
+ *
+ * BitForge http://www.bitforge.com.br
+ * Copyright (c) 2012 All Right Reserved,
+ */
+
+#include "strsearch.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BF_STRSEARCH_X86
+#endif
+
+namespace bitforge
+{
+
+namespace
+{
+
+// Sets of up to this many chars are searched with one compare per char, bigger ones use a table
+const std::size_t MaxVectorSet = 16;
+
+/****************************** Scalar *****************************************/
+
+const char* findCharScalar(const char* data, std::size_t length, char c)
+{
+    for (const char* end = data + length; data != end; data++)
+        if (*data == c)
+            return data;
+    return nullptr;
+}
+
+const char* findCharReverseScalar(const char* data, std::size_t length, char c)
+{
+    for (const char* p = data + length; p != data; )
+        if (*--p == c)
+            return p;
+    return nullptr;
+}
+
+const char* findStringScalar(const char* data, std::size_t length, const char* needle, std::size_t needleLength)
+{
+    const char* last = data + (length - needleLength);
+    for (const char* p = data; p <= last; p++)
+        if (*p == *needle && memcmp(p, needle, needleLength) == 0)
+            return p;
+    return nullptr;
+}
+
+// Membership table for big sets
+struct CharSet
+{
+    bool contains[256];
+
+    CharSet(const char* set, std::size_t setLength): contains()
+    {
+        for (std::size_t i = 0; i < setLength; i++)
+            contains[static_cast<unsigned char>(set[i])] = true;
+    }
+
+    bool operator()(char c) const { return contains[static_cast<unsigned char>(c)]; }
+};
+
+// Small sets are searched with memchr
+struct SmallCharSet
+{
+    const char*     set;
+    std::size_t     setLength;
+
+    bool operator()(char c) const { return memchr(set, c, setLength) != nullptr; }
+};
+
+template<typename Set>
+const char* findFirstOfScalar(const char* data, std::size_t length, const Set& set, bool member)
+{
+    for (const char* end = data + length; data != end; data++)
+        if (set(*data) == member)
+            return data;
+    return nullptr;
+}
+
+template<typename Set>
+const char* findLastOfScalar(const char* data, std::size_t length, const Set& set, bool member)
+{
+    for (const char* p = data + length; p != data; )
+        if (set(*--p) == member)
+            return p;
+    return nullptr;
+}
+
+#ifndef BF_STRSEARCH_X86
+
+const char* findFirstOfScalar(const char* data, std::size_t length, const char* set, std::size_t setLength)
+{
+    return findFirstOfScalar(data, length, SmallCharSet{ set, setLength }, true);
+}
+
+const char* findFirstNotOfScalar(const char* data, std::size_t length, const char* set, std::size_t setLength)
+{
+    return findFirstOfScalar(data, length, SmallCharSet{ set, setLength }, false);
+}
+
+const char* findLastNotOfScalar(const char* data, std::size_t length, const char* set, std::size_t setLength)
+{
+    return findLastOfScalar(data, length, SmallCharSet{ set, setLength }, false);
+}
+
+#endif
+
+inline char asciiLower(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? c | 0x20 : c;
+}
+
+bool asciiCaseEqualScalar(const char* a, const char* b, std::size_t length)
+{
+    for (std::size_t i = 0; i < length; i++)
+        if (a[i] != b[i] && asciiLower(a[i]) != asciiLower(b[i]))
+            return false;
+    return true;
+}
+
+#ifdef BF_STRSEARCH_X86
+
+inline unsigned ctz(uint32_t v) { return __builtin_ctz(v); }
+inline unsigned highestBit(uint32_t v) { return 31 - __builtin_clz(v); }
+
+/****************************** SSE2 *******************************************/
+
+const char* findCharSSE2(const char* data, std::size_t length, char c)
+{
+    const __m128i needle = _mm_set1_epi8(c);
+    const char* p = data;
+    const char* end = data + length;
+
+    for (; p + 16 <= end; p += 16)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const uint32_t mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+        if (mask)
+            return p + ctz(mask);
+    }
+
+    return findCharScalar(p, end - p, c);
+}
+
+const char* findCharReverseSSE2(const char* data, std::size_t length, char c)
+{
+    const __m128i needle = _mm_set1_epi8(c);
+    const char* p = data + length;
+
+    for (; p - data >= 16; p -= 16)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p - 16));
+        const uint32_t mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+        if (mask)
+            return p - 16 + highestBit(mask);
+    }
+
+    return findCharReverseScalar(data, p - data, c);
+}
+
+// Compare the first and last needle chars over 16 positions at once, then verify candidates
+const char* findStringSSE2(const char* data, std::size_t length, const char* needle, std::size_t needleLength)
+{
+    const __m128i first = _mm_set1_epi8(needle[0]);
+    const __m128i last = _mm_set1_epi8(needle[needleLength - 1]);
+
+    const char* p = data;
+    const char* end = data + (length - needleLength + 1); // One past the last possible start
+
+    for (; p + 16 <= end; p += 16)
+    {
+        const __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + needleLength - 1));
+
+        uint32_t mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(blockFirst, first), _mm_cmpeq_epi8(blockLast, last)));
+        while (mask)
+        {
+            const char* candidate = p + ctz(mask);
+            if (memcmp(candidate + 1, needle + 1, needleLength - 2) == 0)
+                return candidate;
+            mask &= mask - 1;
+        }
+    }
+
+    return findStringScalar(p, (data + length) - p, needle, needleLength);
+}
+
+// Bit i of the result is set when byte i of @block is one of the @setLength chars
+inline uint32_t setMaskSSE2(__m128i block, const __m128i* chars, std::size_t setLength)
+{
+    __m128i matches = _mm_cmpeq_epi8(block, chars[0]);
+    for (std::size_t i = 1; i < setLength; i++)
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, chars[i]));
+    return _mm_movemask_epi8(matches);
+}
+
+// @invert is 0xffff to look for chars outside the set
+const char* findSetSSE2(const char* data, std::size_t length, const char* set, std::size_t setLength, uint32_t invert)
+{
+    __m128i chars[MaxVectorSet];
+    for (std::size_t i = 0; i < setLength; i++)
+        chars[i] = _mm_set1_epi8(set[i]);
+
+    const char* p = data;
+    const char* end = data + length;
+
+    for (; p + 16 <= end; p += 16)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const uint32_t mask = setMaskSSE2(block, chars, setLength) ^ invert;
+        if (mask)
+            return p + ctz(mask);
+    }
+
+    return findFirstOfScalar(p, end - p, SmallCharSet{ set, setLength }, !invert);
+}
+
+const char* findSetReverseSSE2(const char* data, std::size_t length, const char* set, std::size_t setLength, uint32_t invert)
+{
+    __m128i chars[MaxVectorSet];
+    for (std::size_t i = 0; i < setLength; i++)
+        chars[i] = _mm_set1_epi8(set[i]);
+
+    const char* p = data + length;
+
+    for (; p - data >= 16; p -= 16)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p - 16));
+        const uint32_t mask = setMaskSSE2(block, chars, setLength) ^ invert;
+        if (mask)
+            return p - 16 + highestBit(mask);
+    }
+
+    return findLastOfScalar(data, p - data, SmallCharSet{ set, setLength }, !invert);
+}
+
+const char* findFirstOfSSE2(const char* data, std::size_t length, const char* set, std::size_t setLength)
+{
+    return findSetSSE2(data, length, set, setLength, 0);
+}
+
+const char* findFirstNotOfSSE2(const char* data, std::size_t length, const char* set, std::size_t setLength)
+{
+    return findSetSSE2(data, length, set, setLength, 0xffff);
+}
+
+const char* findLastNotOfSSE2(const char* data, std::size_t length, const char* set, std::size_t setLength)
+{
+    return findSetReverseSSE2(data, length, set, setLength, 0xffff);
+}
+
+// Lower cases the ASCII letters: 'A'..'Z' are moved to the bottom of the signed range, so
+// a single signed compare picks them
+inline __m128i asciiLowerSSE2(__m128i v)
+{
+    const __m128i shifted = _mm_sub_epi8(v, _mm_set1_epi8('A' + 128));
+    const __m128i isUpper = _mm_cmplt_epi8(shifted, _mm_set1_epi8(-128 + 26));
+    return _mm_or_si128(v, _mm_and_si128(isUpper, _mm_set1_epi8(0x20)));
+}
+
+bool asciiCaseEqualSSE2(const char* a, const char* b, std::size_t length)
+{
+    std::size_t i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        const __m128i va = asciiLowerSSE2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)));
+        const __m128i vb = asciiLowerSSE2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)) != 0xffff)
+            return false;
+    }
+
+    return asciiCaseEqualScalar(a + i, b + i, length - i);
+}
+
+/****************************** AVX2 *******************************************/
+
+__attribute__((target("avx2")))
+const char* findCharAVX2(const char* data, std::size_t length, char c)
+{
+    const __m256i needle = _mm256_set1_epi8(c);
+    const char* p = data;
+    const char* end = data + length;
+
+    for (; p + 32 <= end; p += 32)
+    {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        const uint32_t mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle));
+        if (mask)
+            return p + ctz(mask);
+    }
+
+    return findCharSSE2(p, end - p, c);
+}
+
+__attribute__((target("avx2")))
+const char* findCharReverseAVX2(const char* data, std::size_t length, char c)
+{
+    const __m256i needle = _mm256_set1_epi8(c);
+    const char* p = data + length;
+
+    for (; p - data >= 32; p -= 32)
+    {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p - 32));
+        const uint32_t mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle));
+        if (mask)
+            return p - 32 + highestBit(mask);
+    }
+
+    return findCharReverseSSE2(data, p - data, c);
+}
+
+__attribute__((target("avx2")))
+const char* findStringAVX2(const char* data, std::size_t length, const char* needle, std::size_t needleLength)
+{
+    const __m256i first = _mm256_set1_epi8(needle[0]);
+    const __m256i last = _mm256_set1_epi8(needle[needleLength - 1]);
+
+    const char* p = data;
+    const char* end = data + (length - needleLength + 1);
+
+    for (; p + 32 <= end; p += 32)
+    {
+        const __m256i blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        const __m256i blockLast = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + needleLength - 1));
+
+        uint32_t mask = _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, first), _mm256_cmpeq_epi8(blockLast, last)));
+        while (mask)
+        {
+            const char* candidate = p + ctz(mask);
+            if (memcmp(candidate + 1, needle + 1, needleLength - 2) == 0)
+                return candidate;
+            mask &= mask - 1;
+        }
+    }
+
+    return findStringSSE2(p, (data + length) - p, needle, needleLength);
+}
+
+__attribute__((target("avx2")))
+inline uint32_t setMaskAVX2(__m256i block, const __m256i* chars, std::size_t setLength)
+{
+    __m256i matches = _mm256_cmpeq_epi8(block, chars[0]);
+    for (std::size_t i = 1; i < setLength; i++)
+        matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(block, chars[i]));
+    return _mm256_movemask_epi8(matches);
+}
+
+// @invert is all ones to look for chars outside the set
+__attribute__((target("avx2")))
+const char* findSetAVX2(const char* data, std::size_t length, const char* set, std::size_t setLength, uint32_t invert)
+{
+    __m256i chars[MaxVectorSet];
+    for (std::size_t i = 0; i < setLength; i++)
+        chars[i] = _mm256_set1_epi8(set[i]);
+
+    const char* p = data;
+    const char* end = data + length;
+
+    for (; p + 32 <= end; p += 32)
+    {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        const uint32_t mask = setMaskAVX2(block, chars, setLength) ^ invert;
+        if (mask)
+            return p + ctz(mask);
+    }
+
+    return findSetSSE2(p, end - p, set, setLength, invert & 0xffff);
+}
+
+__attribute__((target("avx2")))
+const char* findSetReverseAVX2(const char* data, std::size_t length, const char* set, std::size_t setLength, uint32_t invert)
+{
+    __m256i chars[MaxVectorSet];
+    for (std::size_t i = 0; i < setLength; i++)
+        chars[i] = _mm256_set1_epi8(set[i]);
+
+    const char* p = data + length;
+
+    for (; p - data >= 32; p -= 32)
+    {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p - 32));
+        const uint32_t mask = setMaskAVX2(block, chars, setLength) ^ invert;
+        if (mask)
+            return p - 32 + highestBit(mask);
+    }
+
+    return findSetReverseSSE2(data, p - data, set, setLength, invert & 0xffff);
+}
+
+__attribute__((target("avx2")))
+const char* findFirstOfAVX2(const char* data, std::size_t length, const char* set, std::size_t setLength)
+{
+    return findSetAVX2(data, length, set, setLength, 0);
+}
+
+__attribute__((target("avx2")))
+const char* findFirstNotOfAVX2(const char* data, std::size_t length, const char* set, std::size_t setLength)
+{
+    return findSetAVX2(data, length, set, setLength, 0xffffffffu);
+}
+
+__attribute__((target("avx2")))
+const char* findLastNotOfAVX2(const char* data, std::size_t length, const char* set, std::size_t setLength)
+{
+    return findSetReverseAVX2(data, length, set, setLength, 0xffffffffu);
+}
+
+__attribute__((target("avx2")))
+inline __m256i asciiLowerAVX2(__m256i v)
+{
+    const __m256i shifted = _mm256_sub_epi8(v, _mm256_set1_epi8('A' + 128));
+    const __m256i isUpper = _mm256_cmpgt_epi8(_mm256_set1_epi8(-128 + 26), shifted);
+    return _mm256_or_si256(v, _mm256_and_si256(isUpper, _mm256_set1_epi8(0x20)));
+}
+
+__attribute__((target("avx2")))
+bool asciiCaseEqualAVX2(const char* a, const char* b, std::size_t length)
+{
+    std::size_t i = 0;
+    for (; i + 32 <= length; i += 32)
+    {
+        const __m256i va = asciiLowerAVX2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)));
+        const __m256i vb = asciiLowerAVX2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+        if (static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb))) != 0xffffffffu)
+            return false;
+    }
+
+    return asciiCaseEqualSSE2(a + i, b + i, length - i);
+}
+
+#endif // BF_STRSEARCH_X86
+
+struct SearchFunctions
+{
+    const char* (*findChar)(const char*, std::size_t, char);
+    const char* (*findCharReverse)(const char*, std::size_t, char);
+    const char* (*findString)(const char*, std::size_t, const char*, std::size_t);
+    const char* (*findFirstOf)(const char*, std::size_t, const char*, std::size_t);
+    const char* (*findFirstNotOf)(const char*, std::size_t, const char*, std::size_t);
+    const char* (*findLastNotOf)(const char*, std::size_t, const char*, std::size_t);
+    bool (*asciiCaseEqual)(const char*, const char*, std::size_t);
+};
+
+SearchFunctions selectFunctions()
+{
+#ifdef BF_STRSEARCH_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return { findCharAVX2, findCharReverseAVX2, findStringAVX2, findFirstOfAVX2, findFirstNotOfAVX2, findLastNotOfAVX2, asciiCaseEqualAVX2 };
+    return { findCharSSE2, findCharReverseSSE2, findStringSSE2, findFirstOfSSE2, findFirstNotOfSSE2, findLastNotOfSSE2, asciiCaseEqualSSE2 };
+#else
+    return { findCharScalar, findCharReverseScalar, findStringScalar, findFirstOfScalar, findFirstNotOfScalar, findLastNotOfScalar, asciiCaseEqualScalar };
+#endif
+}
+
+// Resolved on first use so callers running from other static initializers are safe
+const SearchFunctions& functions()
+{
+    static const SearchFunctions s_functions = selectFunctions();
+    return s_functions;
+}
+
+}
+
+const char* findChar(const char* data, std::size_t length, char c)
+{
+    return functions().findChar(data, length, c);
+}
+
+const char* findCharReverse(const char* data, std::size_t length, char c)
+{
+    return functions().findCharReverse(data, length, c);
+}
+
+const char* findString(const char* data, std::size_t length, const char* needle, std::size_t needleLength)
+{
+    if (needleLength == 0)
+        return data;
+    if (needleLength > length)
+        return nullptr;
+    if (needleLength == 1)
+        return functions().findChar(data, length, needle[0]);
+
+    return functions().findString(data, length, needle, needleLength);
+}
+
+const char* findStringReverse(const char* data, std::size_t length, const char* needle, std::size_t needleLength)
+{
+    if (needleLength == 0)
+        return data + length;
+    if (needleLength > length)
+        return nullptr;
+
+    // Scan backwards for the first needle char among the possible starts, then verify
+    std::size_t starts = length - needleLength + 1;
+    while (starts)
+    {
+        const char* candidate = functions().findCharReverse(data, starts, needle[0]);
+        if (!candidate)
+            return nullptr;
+        if (memcmp(candidate, needle, needleLength) == 0)
+            return candidate;
+        starts = candidate - data;
+    }
+
+    return nullptr;
+}
+
+const char* findFirstOf(const char* data, std::size_t length, const char* set, std::size_t setLength)
+{
+    if (setLength == 0)
+        return nullptr;
+    if (setLength == 1)
+        return functions().findChar(data, length, set[0]);
+    if (setLength > MaxVectorSet)
+        return findFirstOfScalar(data, length, CharSet(set, setLength), true);
+
+    return functions().findFirstOf(data, length, set, setLength);
+}
+
+const char* findFirstNotOf(const char* data, std::size_t length, const char* set, std::size_t setLength)
+{
+    if (setLength == 0)
+        return length ? data : nullptr;
+    if (setLength > MaxVectorSet)
+        return findFirstOfScalar(data, length, CharSet(set, setLength), false);
+
+    return functions().findFirstNotOf(data, length, set, setLength);
+}
+
+const char* findLastNotOf(const char* data, std::size_t length, const char* set, std::size_t setLength)
+{
+    if (setLength == 0)
+        return length ? data + length - 1 : nullptr;
+    if (setLength > MaxVectorSet)
+        return findLastOfScalar(data, length, CharSet(set, setLength), false);
+
+    return functions().findLastNotOf(data, length, set, setLength);
+}
+
+bool asciiCaseEqual(const char* a, const char* b, std::size_t length)
+{
+    if (length < 16)
+        return asciiCaseEqualScalar(a, b, length);
+    return functions().asciiCaseEqual(a, b, length);
+}
+
+} // bitforge
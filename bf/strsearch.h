@@ -0,0 +1,48 @@
+/*
+ * strsearch.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: gianni
+ *
+ * BitForge http://www.bitforge.com.br
+ * Copyright (c) 2012 All Right Reserved,
+ */
+
+#ifndef __INCLUDE_LIBBF_STRSEARCH_H_
+#define __INCLUDE_LIBBF_STRSEARCH_H_
+
+#include <cstddef>
+
+namespace bitforge
+{
+
+// Vectorized search and compare primitives over (pointer, length) ranges. The SSE2 or AVX2
+// implementation is picked at runtime; searches return nullptr when there is no match.
+
+// First occurrence of @c
+const char* findChar(const char* data, std::size_t length, char c);
+
+// Last occurrence of @c
+const char* findCharReverse(const char* data, std::size_t length, char c);
+
+// First occurrence of @needle; an empty needle matches at @data
+const char* findString(const char* data, std::size_t length, const char* needle, std::size_t needleLength);
+
+// Last occurrence of @needle; an empty needle matches at @data + @length
+const char* findStringReverse(const char* data, std::size_t length, const char* needle, std::size_t needleLength);
+
+// First char that is one of the @setLength chars in @set
+const char* findFirstOf(const char* data, std::size_t length, const char* set, std::size_t setLength);
+
+// First char that is not one of the @setLength chars in @set
+const char* findFirstNotOf(const char* data, std::size_t length, const char* set, std::size_t setLength);
+
+// Last char that is not one of the @setLength chars in @set
+const char* findLastNotOf(const char* data, std::size_t length, const char* set, std::size_t setLength);
+
+// Whether the @length chars at @a and @b are equal, ignoring ASCII case
+bool asciiCaseEqual(const char* a, const char* b, std::size_t length);
+
+} // bitforge
+
+#endif // __INCLUDE_LIBBF_STRSEARCH_H_
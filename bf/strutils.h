@@ -0,0 +1,210 @@
+/*
+ * strutils.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: gianni
+ *
+ * BitForge http://www.bitforge.com.br
+ * Copyright (c) 2012 All Right Reserved,
+ */
+
+#ifndef __INCLUDE_LIBBF_STRUTILS_H_
+#define __INCLUDE_LIBBF_STRUTILS_H_
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+
+#include <bf/stringview.h>
+#include <bf/strsearch.h>
+
+namespace bitforge
+{
+
+// Everything here works on views into the source text and never allocates; the source
+// must outlive the views. Scanning goes through the vectorized routines in strsearch.h.
+
+// The chars isspace() accepts in the C locale
+inline StringView whitespace()
+{
+    return StringView(" \t\n\v\f\r", 6);
+}
+
+inline StringView stripLeft(StringView str, StringView chars = whitespace())
+{
+    const char* first = findFirstNotOf(str.data(), str.size(), chars.data(), chars.size());
+    return first ? StringView(first, str.size() - (first - str.data())) : StringView();
+}
+
+inline StringView stripRight(StringView str, StringView chars = whitespace())
+{
+    const char* last = findLastNotOf(str.data(), str.size(), chars.data(), chars.size());
+    return last ? StringView(str.data(), last - str.data() + 1) : StringView();
+}
+
+inline StringView strip(StringView str, StringView chars = whitespace())
+{
+    return stripRight(stripLeft(str, chars), chars);
+}
+
+/**
+ * Splits at every @delimiter, empty fields included: "a,,b" gives "a", "" and "b".
+ */
+class Splitter
+{
+private:
+    StringView  m_rest;
+    char        m_delimiter;
+    bool        m_done;
+
+public:
+    Splitter(StringView str, char delimiter): m_rest(str), m_delimiter(delimiter), m_done(false) {}
+
+    bool next(StringView& token)
+    {
+        if (m_done)
+            return false;
+
+        const char* end = findChar(m_rest.data(), m_rest.size(), m_delimiter);
+        if (!end)
+        {
+            token = m_rest;
+            m_done = true;
+            return true;
+        }
+
+        const std::size_t length = end - m_rest.data();
+        token = StringView(m_rest.data(), length);
+        m_rest = StringView(end + 1, m_rest.size() - length - 1);
+        return true;
+    }
+};
+
+/**
+ * Tokens separated by runs of any of the @delimiters chars, like strtok: "  a  b " gives
+ * "a" and "b".
+ */
+class Tokenizer
+{
+private:
+    StringView  m_rest;
+    StringView  m_delimiters;
+
+public:
+    Tokenizer(StringView str, StringView delimiters = whitespace()):
+        m_rest(str), m_delimiters(delimiters) {}
+
+    bool next(StringView& token)
+    {
+        const char* begin = findFirstNotOf(m_rest.data(), m_rest.size(), m_delimiters.data(), m_delimiters.size());
+        if (!begin)
+            return false;
+
+        const std::size_t left = m_rest.size() - (begin - m_rest.data());
+        const char* end = findFirstOf(begin, left, m_delimiters.data(), m_delimiters.size());
+        const std::size_t length = end ? end - begin : left;
+
+        token = StringView(begin, length);
+        m_rest = StringView(begin + length, left - length);
+        return true;
+    }
+};
+
+/**
+ * Lines ended by "\n" or "\r\n", without the terminators. A final line is only returned if
+ * it is not empty.
+ */
+class LineSplitter
+{
+private:
+    StringView  m_rest;
+
+public:
+    explicit LineSplitter(StringView str): m_rest(str) {}
+
+    bool next(StringView& line)
+    {
+        if (m_rest.empty())
+            return false;
+
+        const char* end = findChar(m_rest.data(), m_rest.size(), '\n');
+        const std::size_t length = end ? end - m_rest.data() : m_rest.size();
+
+        line = StringView(m_rest.data(), length);
+        if (length && line[length - 1] == '\r')
+            line = StringView(line.data(), length - 1);
+
+        m_rest = end ? StringView(end + 1, m_rest.size() - length - 1) : StringView();
+        return true;
+    }
+};
+
+/**
+ * Input range over the tokens of a Splitter, Tokenizer or LineSplitter, for range based for:
+ *
+ *   for (StringView field : split(line, ','))
+ */
+template<typename T>
+class TokenRange
+{
+private:
+    T   m_splitter;
+
+public:
+    class iterator
+    {
+    private:
+        T*          m_splitter;
+        StringView  m_token;
+
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef StringView              value_type;
+        typedef std::ptrdiff_t          difference_type;
+        typedef const StringView*       pointer;
+        typedef const StringView&       reference;
+
+        explicit iterator(T* splitter = nullptr): m_splitter(splitter)
+        {
+            ++*this;
+        }
+
+        const StringView& operator*() const { return m_token; }
+        const StringView* operator->() const { return &m_token; }
+
+        iterator& operator++()
+        {
+            if (m_splitter && !m_splitter->next(m_token))
+                m_splitter = nullptr;
+            return *this;
+        }
+
+        bool operator==(const iterator& other) const { return m_splitter == other.m_splitter; }
+        bool operator!=(const iterator& other) const { return m_splitter != other.m_splitter; }
+    };
+
+    explicit TokenRange(const T& splitter): m_splitter(splitter) {}
+
+    // Single pass: begin() consumes the splitter
+    iterator begin() { return iterator(&m_splitter); }
+    iterator end() { return iterator(); }
+};
+
+inline TokenRange<Splitter> split(StringView str, char delimiter)
+{
+    return TokenRange<Splitter>(Splitter(str, delimiter));
+}
+
+inline TokenRange<Tokenizer> tokenize(StringView str, StringView delimiters = whitespace())
+{
+    return TokenRange<Tokenizer>(Tokenizer(str, delimiters));
+}
+
+inline TokenRange<LineSplitter> lines(StringView str)
+{
+    return TokenRange<LineSplitter>(LineSplitter(str));
+}
+
+} // bitforge
+
+#endif // __INCLUDE_LIBBF_STRUTILS_H_
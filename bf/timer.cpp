@@ -0,0 +1,64 @@
+/*
+ * timer.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: gianni
+ *
+ * BitForge http://www.bitforge.com.br
+ * Copyright (c) 2012 All Right Reserved,
+ */
+
+#include "timer.h"
+
+#ifdef BF_TIMER_TSC
+#include <cpuid.h>
+#endif
+
+namespace bitforge
+{
+
+namespace
+{
+
+const uint64_t CalibrationNanoseconds = 10000000;
+
+}
+
+MonotonicClock::Calibration MonotonicClock::calibrate(uint64_t minimumTicksPerSecond)
+{
+    Calibration calibration = { false, false, uint64_t(1) << 32, 1000000000 };
+
+#ifdef BF_TIMER_TSC
+    unsigned int eax, ebx, ecx, edx;
+
+    // Only a TSC that runs at a constant rate in every power state can measure time
+    if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) || !(edx & (1 << 8)))
+        return calibration;
+
+    const uint64_t startTicks = __rdtsc();
+    const uint64_t start = monotonicNanoseconds();
+    uint64_t end, endTicks;
+
+    do
+    {
+        end = monotonicNanoseconds();
+        endTicks = __rdtsc();
+    }
+    while (end - start < CalibrationNanoseconds);
+
+    const uint64_t ticks = endTicks - startTicks;
+    const uint64_t ticksPerSecond = static_cast<uint64_t>(static_cast<unsigned __int128>(ticks) * 1000000000 / (end - start));
+    if (ticksPerSecond <= minimumTicksPerSecond)
+        return calibration; // Slow, or not counting: clock_gettime() is as good
+
+    // endTicks() must never read the TSC when ticks() doesn't
+    calibration.tsc = true;
+    calibration.rdtscp = __get_cpuid(0x80000001, &eax, &ebx, &ecx, &edx) && (edx & (1 << 27));
+    calibration.ticksPerSecond = ticksPerSecond;
+    calibration.multiplier = static_cast<uint64_t>((static_cast<unsigned __int128>(end - start) << 32) / ticks);
+#endif
+
+    return calibration;
+}
+
+} // bitforge
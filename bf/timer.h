@@ -0,0 +1,139 @@
+/*
+ * timer.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: gianni
+ *
+ * BitForge http://www.bitforge.com.br
+ * Copyright (c) 2012 All Right Reserved,
+ */
+
+#ifndef __INCLUDE_LIBBF_TIMER_H_
+#define __INCLUDE_LIBBF_TIMER_H_
+
+#include <cstdint>
+#include <ctime>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BF_TIMER_TSC
+#endif
+
+namespace bitforge
+{
+
+/**
+ * @class MonotonicClock
+ * @description Monotonic clock for timing code paths, in integer nanoseconds.
+ * On x86 CPUs with an invariant TSC it reads the time stamp counter, calibrated against
+ * CLOCK_MONOTONIC on first use (which takes about 10ms); elsewhere it is
+ * clock_gettime(CLOCK_MONOTONIC).
+ * In hot paths keep the raw ticks() and convert the differences with toNanoseconds().
+ */
+class MonotonicClock
+{
+public:
+    struct Calibration
+    {
+        bool        tsc;
+        bool        rdtscp;         // Only set along with tsc
+        uint64_t    multiplier;     // Nanoseconds per tick, 32.32 fixed point
+        uint64_t    ticksPerSecond;
+    };
+
+    // Measures the TSC, which is only used if it runs faster than @minimumTicksPerSecond
+    static Calibration calibrate(uint64_t minimumTicksPerSecond = 1000000000);
+
+private:
+    static const Calibration& calibration()
+    {
+        static const Calibration s_calibration = calibrate();
+        return s_calibration;
+    }
+
+    static uint64_t monotonicNanoseconds()
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+    }
+
+public:
+    // Current tick count, only differences of two are meaningful
+    static uint64_t ticks()
+    {
+#ifdef BF_TIMER_TSC
+        if (calibration().tsc)
+            return __rdtsc();
+#endif
+        return monotonicNanoseconds();
+    }
+
+    // Like ticks(), but only read once the instructions before it are done: for the end of a measured interval
+    static uint64_t endTicks()
+    {
+#ifdef BF_TIMER_TSC
+        const Calibration& c = calibration();
+        if (c.rdtscp)
+        {
+            unsigned int cpu;
+            return __rdtscp(&cpu);
+        }
+        if (c.tsc)
+            return __rdtsc();
+#endif
+        return monotonicNanoseconds();
+    }
+
+    // Nanoseconds in a difference of ticks
+    static int64_t toNanoseconds(int64_t ticks)
+    {
+        return static_cast<int64_t>((static_cast<__int128>(ticks) * calibration().multiplier) >> 32);
+    }
+
+    // Nanoseconds since some fixed point in the past (about the boot for the TSC)
+    static int64_t now()
+    {
+        return toNanoseconds(ticks());
+    }
+
+    static bool isTsc() { return calibration().tsc; }
+    static uint64_t ticksPerSecond() { return calibration().ticksPerSecond; }
+};
+
+/**
+ * @class ScopedTimer
+ * @description Adds the nanoseconds between its construction and destruction to a counter.
+ *
+ *   int64_t parseTime = 0;
+ *   {
+ *       ScopedTimer timer(parseTime);
+ *       parse(packet);
+ *   }
+ */
+class ScopedTimer
+{
+private:
+    int64_t&        m_total;
+    const uint64_t  m_start;
+
+public:
+    explicit ScopedTimer(int64_t& totalNanoseconds): m_total(totalNanoseconds), m_start(MonotonicClock::ticks()) {}
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    ~ScopedTimer()
+    {
+        m_total += elapsed();
+    }
+
+    int64_t elapsed() const
+    {
+        return MonotonicClock::toNanoseconds(MonotonicClock::endTicks() - m_start);
+    }
+};
+
+} // bitforge
+
+#endif // __INCLUDE_LIBBF_TIMER_H_
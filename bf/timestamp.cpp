@@ -0,0 +1,130 @@
+/*
+ * timestamp.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: gianni
+ *
+ * BitForge http://www.bitforge.com.br
+ * Copyright (c) 2012 All Right Reserved,
+ */
+
+#include "timestamp.h"
+#include "bf.h"
+
+#include <ctime>
+
+namespace bitforge
+{
+
+namespace
+{
+
+// The coarse clock is only used for milliseconds when it ticks at least that often
+bool coarseMilliseconds()
+{
+    static const bool s_coarse = []
+    {
+        struct timespec resolution;
+        return clock_getres(CLOCK_REALTIME_COARSE, &resolution) == 0 &&
+               resolution.tv_sec == 0 && resolution.tv_nsec <= 1000000;
+    }();
+    return s_coarse;
+}
+
+}
+
+const std::size_t TimestampCache::MaxLength;
+
+TimestampCache::TimestampCache(TimeZone timeZone, char dateSeparator, char separator, char timeSeparator):
+    m_timeZone(timeZone),
+    m_dateSeparator(dateSeparator),
+    m_separator(separator),
+    m_timeSeparator(timeSeparator),
+    m_length(14 + (dateSeparator ? 2 : 0) + (separator ? 1 : 0) + (timeSeparator ? 2 : 0)),
+    m_sequence(0),
+    m_second(-1)
+{
+    static_assert(TextWords * sizeof(uint64_t) >= 19, "TimestampCache text doesn't fit");
+
+    for (std::atomic<uint64_t>& word : m_text)
+        word.store(0, std::memory_order_relaxed);
+}
+
+char* TimestampCache::formatSecond(char* buffer, int64_t second)
+{
+    const time_t t = static_cast<time_t>(second);
+    struct tm tm;
+
+    if (m_timeZone == tzUTC)
+        gmtime_r(&t, &tm);
+    else
+        localtime_r(&t, &tm);
+
+    char* end = formatDateTime(buffer, tm, m_dateSeparator, m_separator, m_timeSeparator);
+
+    // Publish it, unless another thread is doing the same
+    uint32_t sequence = m_sequence.load(std::memory_order_relaxed);
+    if (!(sequence & 1) && m_sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_relaxed))
+    {
+        std::atomic_thread_fence(std::memory_order_release);
+
+        uint64_t words[TextWords] = {};
+        memcpy(words, buffer, m_length);
+
+        m_second.store(second, std::memory_order_relaxed);
+        for (std::size_t i = 0; i < TextWords; i++)
+            m_text[i].store(words[i], std::memory_order_relaxed);
+
+        m_sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    return end;
+}
+
+char* TimestampCache::format(char* buffer, TimestampPrecision precision)
+{
+    struct timespec now;
+    const bool coarse = precision == tpSeconds || (precision == tpMilliseconds && coarseMilliseconds());
+    clock_gettime(coarse ? CLOCK_REALTIME_COARSE : CLOCK_REALTIME, &now);
+
+    char* c;
+    const uint32_t sequence = m_sequence.load(std::memory_order_acquire);
+    bool cached = false;
+
+    if (!(sequence & 1) && m_second.load(std::memory_order_relaxed) == now.tv_sec)
+    {
+        uint64_t words[TextWords];
+        for (std::size_t i = 0; i < TextWords; i++)
+            words[i] = m_text[i].load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_sequence.load(std::memory_order_relaxed) == sequence)
+        {
+            memcpy(buffer, words, m_length);
+            cached = true;
+        }
+    }
+
+    c = cached ? buffer + m_length : formatSecond(buffer, now.tv_sec);
+
+    switch (precision)
+    {
+        case tpMilliseconds:
+            *c++ = '.';
+            c = formatFixed<3>(c, static_cast<uint32_t>(now.tv_nsec / 1000000));
+            break;
+
+        case tpMicroseconds:
+            *c++ = '.';
+            c = formatFixed<6>(c, static_cast<uint32_t>(now.tv_nsec / 1000));
+            break;
+
+        case tpSeconds:
+        default:
+            break;
+    }
+
+    return c;
+}
+
+} // bitforge
@@ -0,0 +1,85 @@
+/*
+ * timestamp.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: gianni
+ *
+ * BitForge http://www.bitforge.com.br
+ * Copyright (c) 2012 All Right Reserved,
+ */
+
+#ifndef __INCLUDE_LIBBF_TIMESTAMP_H_
+#define __INCLUDE_LIBBF_TIMESTAMP_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace bitforge
+{
+
+enum TimestampPrecision
+{
+    tpSeconds,
+    tpMilliseconds,     // ".mmm" added
+    tpMicroseconds      // ".uuuuuu" added
+};
+
+/**
+ * @class TimestampCache
+ * @description Current date and time as text, YYYY MM DD HH MM SS with the given separators
+ * (0 for none), in UTC or local time.
+ * The text of the current second is formatted once and published to all threads with a
+ * seqlock; other calls in that second just copy it and add the fraction, if asked for.
+ * Seconds and milliseconds come from CLOCK_REALTIME_COARSE when its resolution allows,
+ * microseconds always from CLOCK_REALTIME.
+ *
+ *   static TimestampCache s_logTime(tzLocal, '-', ' ', ':');
+ *   char* end = s_logTime.format(buffer, tpMilliseconds);
+ */
+class TimestampCache
+{
+public:
+    enum TimeZone
+    {
+        tzUTC,
+        tzLocal
+    };
+
+    // Longest text format() writes
+    static const std::size_t MaxLength = 26;
+
+private:
+    static const std::size_t TextWords = 3;
+
+    const TimeZone              m_timeZone;
+    const char                  m_dateSeparator;
+    const char                  m_separator;
+    const char                  m_timeSeparator;
+    const std::size_t           m_length;
+
+    // Odd while the cache is being written
+    std::atomic<uint32_t>       m_sequence;
+    std::atomic<int64_t>        m_second;
+    std::atomic<uint64_t>       m_text[TextWords];
+
+    char* formatSecond(char* buffer, int64_t second);
+
+public:
+    TimestampCache(TimeZone timeZone, char dateSeparator, char separator, char timeSeparator);
+
+    TimestampCache(const TimestampCache&) = delete;
+    TimestampCache& operator=(const TimestampCache&) = delete;
+
+    // Writes the current time to @buffer, which takes at least MaxLength chars, returns the end
+    char* format(char* buffer, TimestampPrecision precision = tpSeconds);
+
+    std::size_t length(TimestampPrecision precision = tpSeconds) const
+    {
+        return m_length + (precision == tpMilliseconds ? 4 : precision == tpMicroseconds ? 7 : 0);
+    }
+};
+
+} // bitforge
+
+#endif // __INCLUDE_LIBBF_TIMESTAMP_H_
@@ -0,0 +1,345 @@
+/*
+ * topology.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: gianni
+ *
+ * BitForge http://www.bitforge.com.br
+ * Copyright (c) 2012 All Right Reserved,
+ */
+
+#include "topology.h"
+#include "inthex.h"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <utility>
+
+#include <cerrno>
+
+#include <sched.h>
+#include <unistd.h>
+
+namespace bitforge
+{
+
+namespace
+{
+
+// First line of a sysfs file, false if it can't be read
+bool readLine(const std::string& path, std::string& line)
+{
+    std::ifstream file(path);
+    return std::getline(file, line) && !line.empty();
+}
+
+bool readInt(const std::string& path, int& value)
+{
+    std::string line;
+    int32_t v;
+    if (!readLine(path, line) || !parseInt(line.data(), line.size(), v))
+        return false;
+
+    value = v;
+    return true;
+}
+
+// Cache sizes are written as "48K", "2048K" or "1M"
+bool readSize(const std::string& path, std::size_t& size)
+{
+    std::string line;
+    uint64_t v;
+    if (!readLine(path, line))
+        return false;
+
+    const ParseResult res = parseUint(line.data(), line.size(), v);
+    if (res.error != peNone)
+        return false;
+
+    switch (res.end == line.data() + line.size() ? 0 : *res.end)
+    {
+        case 'K': v <<= 10; break;
+        case 'M': v <<= 20; break;
+        case 'G': v <<= 30; break;
+        default: break;
+    }
+
+    size = static_cast<std::size_t>(v);
+    return true;
+}
+
+std::size_t sysconfSize(int name)
+{
+    const long value = sysconf(name);
+    return value > 0 ? static_cast<std::size_t>(value) : 0;
+}
+
+// What glibc knows about the caches, for when sysfs has no cache directory
+void sysconfCaches(std::vector<CpuCache>& caches)
+{
+    struct Level { int level; CacheType type; int size; int lineSize; };
+    static const Level levels[] =
+    {
+        { 1, ctData, _SC_LEVEL1_DCACHE_SIZE, _SC_LEVEL1_DCACHE_LINESIZE },
+        { 1, ctInstruction, _SC_LEVEL1_ICACHE_SIZE, _SC_LEVEL1_ICACHE_LINESIZE },
+        { 2, ctUnified, _SC_LEVEL2_CACHE_SIZE, _SC_LEVEL2_CACHE_LINESIZE },
+        { 3, ctUnified, _SC_LEVEL3_CACHE_SIZE, _SC_LEVEL3_CACHE_LINESIZE },
+        { 4, ctUnified, _SC_LEVEL4_CACHE_SIZE, _SC_LEVEL4_CACHE_LINESIZE },
+    };
+
+    for (const Level& level : levels)
+    {
+        const std::size_t size = sysconfSize(level.size);
+        if (size)
+            caches.push_back({ level.level, level.type, size, sysconfSize(level.lineSize), 0 });
+    }
+}
+
+}
+
+bool parseCpuList(const std::string& list, std::vector<int>& cpus)
+{
+    const char* c = list.data();
+    const char* const end = c + list.size();
+
+    cpus.clear();
+    while (c != end && *c != '\n')
+    {
+        uint32_t first, last;
+        ParseResult res = parseUint(c, end - c, first);
+        if (!res)
+            return false;
+        c = res.end;
+        last = first;
+
+        if (c != end && *c == '-')
+        {
+            res = parseUint(c + 1, end - c - 1, last);
+            if (!res || last < first)
+                return false;
+            c = res.end;
+        }
+
+        for (uint32_t cpu = first; cpu <= last; cpu++)
+            cpus.push_back(static_cast<int>(cpu));
+
+        if (c != end && *c == ',')
+            c++;
+        else if (c != end && *c != '\n')
+            return false;
+    }
+
+    return true;
+}
+
+CpuTopology::CpuTopology(const std::string& sysfsRoot):
+    m_cores(0),
+    m_packages(0),
+    m_nodes(0),
+    m_configuredCpus(0)
+{
+    const std::string cpuRoot = sysfsRoot + "/cpu/";
+    std::string line;
+    std::vector<int> ids;
+
+    if (!readLine(cpuRoot + "online", line) || !parseCpuList(line, ids) || ids.empty())
+    {
+        ids.clear();
+        const long online = sysconf(_SC_NPROCESSORS_ONLN);
+        for (long id = 0; id < std::max(online, 1l); id++)
+            ids.push_back(static_cast<int>(id));
+    }
+
+    std::vector<int> present;
+    if (readLine(cpuRoot + "present", line) && parseCpuList(line, present) && !present.empty())
+        m_configuredCpus = static_cast<int>(present.size());
+    else
+        m_configuredCpus = std::max(static_cast<int>(sysconf(_SC_NPROCESSORS_CONF)), static_cast<int>(ids.size()));
+
+    // Physical cores are numbered within their package, so the pair is the key
+    std::map<std::pair<int, int>, int> coreIndex;
+    std::map<int, int> packageIndex;
+
+    for (int id : ids)
+    {
+        const std::string topology = cpuRoot + "cpu" + std::to_string(id) + "/topology/";
+        int package = 0, core = id;
+
+        readInt(topology + "physical_package_id", package);
+        readInt(topology + "core_id", core);
+
+        auto coreIt = coreIndex.emplace(std::make_pair(package, core), static_cast<int>(coreIndex.size())).first;
+        auto packageIt = packageIndex.emplace(package, static_cast<int>(packageIndex.size())).first;
+
+        m_cpus.push_back({ id, coreIt->second, packageIt->second, 0 });
+    }
+
+    m_cores = static_cast<int>(coreIndex.size());
+    m_packages = static_cast<int>(packageIndex.size());
+
+    std::vector<int> nodes;
+    if (readLine(sysfsRoot + "/node/online", line) && parseCpuList(line, nodes) && !nodes.empty())
+    {
+        for (int node : nodes)
+        {
+            std::vector<int> nodeCpus;
+            if (!readLine(sysfsRoot + "/node/node" + std::to_string(node) + "/cpulist", line) || !parseCpuList(line, nodeCpus))
+                continue;
+
+            for (CpuInfo& info : m_cpus)
+            {
+                if (std::binary_search(nodeCpus.begin(), nodeCpus.end(), info.id))
+                    info.node = node;
+            }
+        }
+        m_nodes = static_cast<int>(nodes.size());
+    }
+    else
+        m_nodes = 1;
+
+    const std::string cacheRoot = cpuRoot + "cpu" + std::to_string(m_cpus.front().id) + "/cache/index";
+    for (int index = 0; ; index++)
+    {
+        const std::string dir = cacheRoot + std::to_string(index) + "/";
+        CpuCache cache = { 0, ctUnified, 0, 0, 0 };
+
+        if (!readInt(dir + "level", cache.level))
+            break;
+
+        if (readLine(dir + "type", line))
+            cache.type = line == "Data" ? ctData : line == "Instruction" ? ctInstruction : ctUnified;
+
+        readSize(dir + "size", cache.size);
+        readSize(dir + "coherency_line_size", cache.lineSize);
+
+        std::vector<int> shared;
+        if (readLine(dir + "shared_cpu_list", line) && parseCpuList(line, shared))
+            cache.sharedCpus = static_cast<int>(shared.size());
+
+        m_caches.push_back(cache);
+    }
+
+    if (m_caches.empty())
+        sysconfCaches(m_caches);
+}
+
+const CpuTopology& CpuTopology::instance()
+{
+    static const CpuTopology s_topology("/sys/devices/system");
+    return s_topology;
+}
+
+const CpuInfo* CpuTopology::cpu(int id) const
+{
+    auto it = std::lower_bound(m_cpus.begin(), m_cpus.end(), id, [](const CpuInfo& info, int id) { return info.id < id; });
+    return it != m_cpus.end() && it->id == id ? &*it : nullptr;
+}
+
+std::vector<int> CpuTopology::siblings(int id) const
+{
+    std::vector<int> ret;
+
+    const CpuInfo* info = cpu(id);
+    if (info)
+    {
+        for (const CpuInfo& other : m_cpus)
+        {
+            if (other.core == info->core)
+                ret.push_back(other.id);
+        }
+    }
+
+    return ret;
+}
+
+std::vector<int> CpuTopology::nodeCpus(int node) const
+{
+    std::vector<int> ret;
+
+    for (const CpuInfo& info : m_cpus)
+    {
+        if (info.node == node)
+            ret.push_back(info.id);
+    }
+
+    return ret;
+}
+
+std::vector<int> CpuTopology::firstCpuOfEachCore() const
+{
+    std::vector<int> ret;
+    std::vector<bool> seen(m_cores, false);
+
+    for (const CpuInfo& info : m_cpus)
+    {
+        if (!seen[info.core])
+        {
+            seen[info.core] = true;
+            ret.push_back(info.id);
+        }
+    }
+
+    return ret;
+}
+
+std::size_t CpuTopology::cacheSize(int level) const
+{
+    for (const CpuCache& cache : m_caches)
+    {
+        if (cache.level == level && cache.type != ctInstruction)
+            return cache.size;
+    }
+
+    return 0;
+}
+
+std::size_t CpuTopology::cacheLineSize() const
+{
+    for (const CpuCache& cache : m_caches)
+    {
+        if (cache.level == 1 && cache.type != ctInstruction && cache.lineSize)
+            return cache.lineSize;
+    }
+
+    return 64;
+}
+
+std::vector<int> CpuTopology::affinity()
+{
+    std::vector<int> ret;
+
+    // The mask has to cover every CPU the kernel may report, which can be more than are present
+    for (int cpus = std::max(instance().configuredCpus(), CPU_SETSIZE); cpus <= (1 << 16); cpus *= 2)
+    {
+        cpu_set_t* set = CPU_ALLOC(cpus);
+        const std::size_t size = CPU_ALLOC_SIZE(cpus);
+
+        if (sched_getaffinity(0, size, set) == 0)
+        {
+            for (int cpu = 0; cpu < cpus; cpu++)
+            {
+                if (CPU_ISSET_S(cpu, size, set))
+                    ret.push_back(cpu);
+            }
+            CPU_FREE(set);
+            return ret;
+        }
+
+        CPU_FREE(set);
+        if (errno != EINVAL)
+            break;
+    }
+
+    for (const CpuInfo& info : instance().cpus())
+        ret.push_back(info.id);
+    return ret;
+}
+
+int CpuTopology::availableCpus()
+{
+    const std::vector<int> cpus = affinity();
+    return std::max(static_cast<int>(cpus.size()), 1);
+}
+
+} // bitforge
@@ -0,0 +1,114 @@
+/*
+ * topology.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: gianni
+ *
+ * BitForge http://www.bitforge.com.br
+ * Copyright (c) 2012 All Right Reserved,
+ */
+
+#ifndef __INCLUDE_LIBBF_TOPOLOGY_H_
+#define __INCLUDE_LIBBF_TOPOLOGY_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace bitforge
+{
+
+enum CacheType
+{
+    ctData,
+    ctInstruction,
+    ctUnified
+};
+
+struct CpuCache
+{
+    int             level;
+    CacheType       type;
+    std::size_t     size;           // bytes
+    std::size_t     lineSize;       // bytes
+    int             sharedCpus;     // logical CPUs sharing this cache
+};
+
+struct CpuInfo
+{
+    int     id;         // logical CPU number, as used by sched_setaffinity
+    int     core;       // index of the physical core, 0 to cores() - 1
+    int     package;
+    int     node;       // NUMA node
+};
+
+/**
+ * @class CpuTopology
+ * @description What the machine looks like: online CPUs, the physical cores and packages they
+ * belong to, SMT siblings, the caches seen by the first CPU and the NUMA nodes.
+ * It is read once from sysconf and /sys/devices/system; nothing is forked, and anything
+ * missing (containers, old kernels) falls back to one core per CPU, one node and the
+ * sysconf cache sizes.
+ * The affinity mask can change at any time so it is read on every call.
+ */
+class CpuTopology
+{
+private:
+    std::vector<CpuInfo>    m_cpus;
+    std::vector<CpuCache>   m_caches;
+    int                     m_cores;
+    int                     m_packages;
+    int                     m_nodes;
+    int                     m_configuredCpus;
+
+public:
+    // Reads the tree under @sysfsRoot, normally /sys/devices/system
+    explicit CpuTopology(const std::string& sysfsRoot);
+
+    // The topology of this machine, read on first use
+    static const CpuTopology& instance();
+
+    // Logical CPUs online, never less than 1
+    int onlineCpus() const { return static_cast<int>(m_cpus.size()); }
+    int configuredCpus() const { return m_configuredCpus; }
+    int cores() const { return m_cores; }
+    int packages() const { return m_packages; }
+    int numaNodes() const { return m_nodes; }
+    int threadsPerCore() const { return (onlineCpus() + m_cores - 1) / m_cores; }
+
+    // Online CPUs, sorted by id
+    const std::vector<CpuInfo>& cpus() const { return m_cpus; }
+
+    // Info for logical CPU @id, nullptr if it is not online
+    const CpuInfo* cpu(int id) const;
+
+    // The online CPUs sharing @id's physical core, @id included
+    std::vector<int> siblings(int id) const;
+
+    // The online CPUs of NUMA node @node
+    std::vector<int> nodeCpus(int node) const;
+
+    // One online CPU per physical core, for pinning threads that shouldn't share a core
+    std::vector<int> firstCpuOfEachCore() const;
+
+    const std::vector<CpuCache>& caches() const { return m_caches; }
+
+    // Size of the data (or unified) cache at @level, 0 if there is none
+    std::size_t cacheSize(int level) const;
+
+    // Coherency line size of the first level data cache, 64 if unknown
+    std::size_t cacheLineSize() const;
+
+    // CPUs the calling thread may run on
+    static std::vector<int> affinity();
+
+    // Number of CPUs the calling thread may run on, the size to give a thread pool
+    static int availableCpus();
+};
+
+// Parses a kernel CPU list such as "0-3,8,10-11" into @cpus, false if it is malformed
+bool parseCpuList(const std::string& list, std::vector<int>& cpus);
+
+} // bitforge
+
+#endif // __INCLUDE_LIBBF_TOPOLOGY_H_
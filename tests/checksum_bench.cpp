@@ -0,0 +1,174 @@
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <bf/checksum.h>
+
+using namespace bitforge;
+
+static const std::vector<char>& data()
+{
+    static std::vector<char> data;
+    if (data.empty())
+    {
+        data.resize(64 * 1024 + 1);
+        for (std::size_t i = 0; i < data.size(); i++)
+            data[i] = static_cast<char>(i * 131 ^ (i >> 8));
+    }
+    return data;
+}
+
+// The scalar loop fletcher32 used before
+static uint32_t fletcher32Scalar(const char *data, std::size_t len)
+{
+    uint32_t sum1 = 0xffff, sum2 = 0xffff;
+    len /= 2;
+
+    while (len)
+    {
+        unsigned tlen = len > 360 ? 360 : len;
+        len -= tlen;
+        do
+        {
+            uint16_t word;
+            memcpy(&word, data, 2);
+            data += 2;
+            sum1 += word;
+            sum2 += sum1;
+        }
+        while (--tlen);
+
+        sum1 = (sum1 & 0xffff) + (sum1 >> 16);
+        sum2 = (sum2 & 0xffff) + (sum2 >> 16);
+    }
+
+    sum1 = (sum1 & 0xffff) + (sum1 >> 16);
+    sum2 = (sum2 & 0xffff) + (sum2 >> 16);
+    return sum2 << 16 | sum1;
+}
+
+static void Fletcher32ScalarLoop(benchmark::State& state)
+{
+    // Unaligned on purpose
+    const char* p = data().data() + 1;
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(fletcher32Scalar(p, state.range(0)));
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Fletcher32ScalarLoop)->Arg(64)->Arg(1500)->Arg(64 * 1024);
+
+static void Fletcher32Dispatched(benchmark::State& state)
+{
+    const char* p = data().data() + 1;
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(fletcher32(p, state.range(0)));
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Fletcher32Dispatched)->Arg(64)->Arg(1500)->Arg(64 * 1024);
+
+static void Fletcher32Incremental(benchmark::State& state)
+{
+    // Pieces of 4095 bytes, like pages with an odd split
+    const char* p = data().data() + 1;
+
+    for (auto _ : state)
+    {
+        Fletcher32 sum;
+        for (std::size_t pos = 0; pos < 64 * 1024; pos += 4095)
+            sum.update(p + pos, std::min<std::size_t>(4095, 64 * 1024 - pos));
+        benchmark::DoNotOptimize(sum.finalize());
+    }
+    state.SetBytesProcessed(state.iterations() * 64 * 1024);
+}
+BENCHMARK(Fletcher32Incremental);
+
+// Bit at a time, what a quick inline CRC usually looks like
+static uint32_t crc32Mpeg2Bitwise(const uint8_t* data, std::size_t len)
+{
+    uint32_t crc = 0xffffffff;
+    while (len--)
+    {
+        crc ^= static_cast<uint32_t>(*data++) << 24;
+        for (int bit = 0; bit < 8; bit++)
+            crc = (crc << 1) ^ (crc & 0x80000000 ? 0x04c11db7 : 0);
+    }
+    return crc;
+}
+
+static void Crc32Mpeg2Bitwise(benchmark::State& state)
+{
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(data().data()) + 1;
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(crc32Mpeg2Bitwise(p, state.range(0)));
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Crc32Mpeg2Bitwise)->Arg(188)->Arg(1024);
+
+static void Crc32Mpeg2Dispatched(benchmark::State& state)
+{
+    const char* p = data().data() + 1;
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(crc32Mpeg2(p, state.range(0)));
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Crc32Mpeg2Dispatched)->Arg(188)->Arg(1024)->Arg(64 * 1024);
+
+static void Crc32cDispatched(benchmark::State& state)
+{
+    const char* p = data().data() + 1;
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(crc32c(p, state.range(0)));
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Crc32cDispatched)->Arg(188)->Arg(1024)->Arg(64 * 1024);
+
+static void Hash64Short(benchmark::State& state)
+{
+    // Hash table keys
+    const char* p = data().data();
+    std::size_t i = 0;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(hash64(p + (i & 1023), 8 + (i & 15)));
+        i++;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(Hash64Short);
+
+static void StdHashShort(benchmark::State& state)
+{
+    // The same slices Hash64Short hashes, built up front
+    std::vector<std::string> keys;
+    for (std::size_t i = 0; i < 1024; i++)
+        keys.emplace_back(data().data() + i, 8 + (i & 15));
+
+    std::size_t i = 0;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(std::hash<std::string>()(keys[i & 1023]));
+        i++;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(StdHashShort);
+
+static void Hash64Long(benchmark::State& state)
+{
+    const char* p = data().data() + 1;
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(hash64(p, state.range(0)));
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Hash64Long)->Arg(1024)->Arg(64 * 1024);
@@ -107,3 +107,19 @@ TEST(Buffers, CircularBuffers)
     
     ASSERT_EQ(in.good(), out.good());
 }
+
+TEST(Buffers, CircularBufferFletcher32)
+{
+    CircularBuffer<char> buffer(1000);
+    vector<char> data(1000);
+    for (size_t i = 0; i < data.size(); i++)
+        data[i] = static_cast<char>(i * 13);
+
+    // Readable data wrapping around the end
+    buffer.push(data.data(), 701);
+    buffer.discard(701);
+    buffer.push(data.data(), 555);
+
+    ASSERT_EQ(Fletcher32().update(buffer).finalize(), fletcher32(data.data(), 555));
+    ASSERT_EQ(buffer.availableReadSize(), 555u);
+}
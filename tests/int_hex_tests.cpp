@@ -1,7 +1,16 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <limits>
+#include <random>
+#include <string>
+#include <vector>
 
+#include "../bf/floatfmt.h"
 #include "../bf/inthex.h"
 
 using namespace bitforge;
@@ -123,3 +132,314 @@ TEST(IntStr, TestUIntToHex)
     ASSERT_STREQ(uinttohex(buffer, bufferSize, 17485327), "10ACE0F");
     ASSERT_STREQ(uinttohex(buffer, bufferSize, 1234567890), "499602D2");
 }
+
+// Values around every power of 10 plus the type limits
+template<typename T>
+static std::vector<T> edgeValues()
+{
+    std::vector<T> values = { 0, 1, std::numeric_limits<T>::max(), std::numeric_limits<T>::min() };
+    for (T p = 1; p <= std::numeric_limits<T>::max() / 10; p *= 10)
+    {
+        for (T v : { T(p * 10 - 1), T(p * 10), T(p * 10 + 1) })
+        {
+            values.push_back(v);
+            if (std::numeric_limits<T>::is_signed)
+                values.push_back(-v);
+        }
+    }
+    return values;
+}
+
+TEST(IntStr, TestDecimalDigits)
+{
+    for (uint64_t v : edgeValues<uint64_t>())
+        ASSERT_EQ(std::to_string(v).size(), decimalDigits(v)) << v;
+    for (uint32_t v : edgeValues<uint32_t>())
+        ASSERT_EQ(std::to_string(v).size(), decimalDigits(v)) << v;
+}
+
+TEST(IntStr, TestLeftAligned)
+{
+    char buffer[32];
+
+    for (uint32_t v : edgeValues<uint32_t>())
+        ASSERT_EQ(std::to_string(v), std::string(buffer, u32toa(buffer, v)));
+    for (int32_t v : edgeValues<int32_t>())
+        ASSERT_EQ(std::to_string(v), std::string(buffer, i32toa(buffer, v)));
+    for (uint64_t v : edgeValues<uint64_t>())
+        ASSERT_EQ(std::to_string(v), std::string(buffer, u64toa(buffer, v)));
+    for (int64_t v : edgeValues<int64_t>())
+    {
+        ASSERT_EQ(std::to_string(v), std::string(buffer, i64toa(buffer, v)));
+        ASSERT_STREQ(std::to_string(v).c_str(), int64tostr(buffer, sizeof(buffer), v));
+    }
+
+    // Nothing is written past the digits
+    memset(buffer, 'x', sizeof(buffer));
+    ASSERT_EQ(3u, u32toa(buffer, 123));
+    ASSERT_EQ('x', buffer[3]);
+}
+
+TEST(IntStr, TestBytesToHex)
+{
+    std::vector<uint8_t> bytes;
+    for (int i = 0; i < 300; i++)
+        bytes.push_back(i * 37 + 11);
+
+    // Every length up to past the 32 byte vectors, against the scalar per byte version
+    for (std::size_t length = 0; length <= bytes.size(); length += (length < 70 ? 1 : 29))
+    {
+        std::string expectedUpper, expectedLower;
+        char pair[3];
+        for (std::size_t i = 0; i < length; i++)
+        {
+            snprintf(pair, sizeof(pair), "%02X", bytes[i]);
+            expectedUpper += pair;
+            snprintf(pair, sizeof(pair), "%02x", bytes[i]);
+            expectedLower += pair;
+        }
+
+        std::string hex(2 * length + 1, '#');
+        bytesToHex(&hex[0], bytes.data(), length);
+        ASSERT_EQ(expectedUpper + "#", hex) << length;
+
+        bytesToHex(&hex[0], bytes.data(), length, hcLower);
+        ASSERT_EQ(expectedLower + "#", hex) << length;
+
+        std::vector<uint8_t> decoded(length + 1, 0xee);
+        ASSERT_EQ(2 * length, hexToBytes(decoded.data(), expectedUpper.data(), expectedUpper.size()));
+        ASSERT_EQ(2 * length, hexToBytes(decoded.data(), expectedLower.data(), expectedLower.size()));
+        ASSERT_TRUE(std::equal(bytes.begin(), bytes.begin() + length, decoded.begin())) << length;
+        ASSERT_EQ(0xee, decoded[length]);
+    }
+}
+
+TEST(IntStr, TestHexToBytesErrors)
+{
+    std::string hex;
+    for (int i = 0; i < 100; i++)
+        hex += "0aF9";
+
+    std::vector<uint8_t> decoded(hex.size());
+
+    // An invalid char at every position, in vector blocks and in the tail
+    for (std::size_t pos = 0; pos < hex.size(); pos++)
+    {
+        for (char bad : { 'g', 'G', '/', ':', '@', '`', ' ', '\0', '\xff' })
+        {
+            std::string broken = hex;
+            broken[pos] = bad;
+            ASSERT_EQ(pos, hexToBytes(decoded.data(), broken.data(), broken.size())) << pos << " " << int(bad);
+        }
+    }
+
+    // Unpaired last digit
+    ASSERT_EQ(hex.size() - 2, hexToBytes(decoded.data(), hex.data(), hex.size() - 1));
+    ASSERT_EQ(0u, hexToBytes(decoded.data(), "A", 1));
+    ASSERT_EQ(0u, hexToBytes(decoded.data(), "", 0));
+}
+
+TEST(IntStr, TestParseUint)
+{
+    uint64_t v64 = 7;
+    uint32_t v32 = 7;
+
+    // Every width, so the 8 digit blocks are mixed with the scalar tail
+    for (uint64_t v : edgeValues<uint64_t>())
+    {
+        const std::string str = std::to_string(v) + "/";
+        ASSERT_TRUE(parseUint(str.data(), str.size(), v64));
+        ASSERT_EQ(v, v64);
+        ASSERT_EQ(str.data() + str.size() - 1, parseUint(str.data(), str.size(), v64).end);
+
+        const ParseResult res = parseUint(str.data(), str.size(), v32);
+        ASSERT_EQ(v <= UINT32_MAX ? peNone : peOverflow, res.error) << v;
+        ASSERT_EQ(str.data() + str.size() - 1, res.end);
+        if (v <= UINT32_MAX)
+        {
+            ASSERT_EQ(v, v32);
+        }
+    }
+
+    const std::string tooBig = "18446744073709551616";
+    v64 = 5;
+    const ParseResult overflow = parseUint(tooBig.data(), tooBig.size(), v64);
+    ASSERT_EQ(peOverflow, overflow.error);
+    ASSERT_EQ(tooBig.data() + tooBig.size(), overflow.end);
+    ASSERT_EQ(5u, v64);
+
+    const std::string padded = "000000000000000000000000000042";
+    ASSERT_TRUE(parseUint(padded.data(), padded.size(), v32));
+    ASSERT_EQ(42u, v32);
+
+    const char* text = "x12";
+    ASSERT_EQ(peNoDigits, parseUint(text, 3, v32).error);
+    ASSERT_EQ(text, parseUint(text, 3, v32).end);
+    ASSERT_EQ(peNoDigits, parseUint(text, 0, v32).error);
+
+    // Only the given length is looked at
+    ASSERT_TRUE(parseUint("123456789", 4, v32));
+    ASSERT_EQ(1234u, v32);
+
+    ASSERT_TRUE(parseUint("ffFFffFF", 8, v32, 16));
+    ASSERT_EQ(UINT32_MAX, v32);
+    ASSERT_EQ(peOverflow, parseUint("100000000", 9, v32, 16).error);
+    ASSERT_TRUE(parseUint("499602D2g", 9, v64, 16));
+    ASSERT_EQ(1234567890u, v64);
+    ASSERT_EQ(peOverflow, parseUint("10000000000000000", 17, v64, 16).error);
+}
+
+TEST(IntStr, TestParseInt)
+{
+    int64_t v64 = 7;
+    int32_t v32 = 7;
+
+    for (int64_t v : edgeValues<int64_t>())
+    {
+        const std::string str = std::to_string(v);
+        ASSERT_TRUE(parseInt(str.data(), str.size(), v64)) << v;
+        ASSERT_EQ(v, v64);
+
+        const bool fits = v >= INT32_MIN && v <= INT32_MAX;
+        ASSERT_EQ(fits ? peNone : peOverflow, parseInt(str.data(), str.size(), v32).error) << v;
+        if (fits)
+        {
+            ASSERT_EQ(v, v32);
+        }
+    }
+
+    ASSERT_EQ(peOverflow, parseInt("9223372036854775808", 19, v64).error);
+    ASSERT_EQ(peOverflow, parseInt("-9223372036854775809", 20, v64).error);
+    ASSERT_EQ(peOverflow, parseInt("2147483648", 10, v32).error);
+    ASSERT_TRUE(parseInt("-2147483648", 11, v32));
+    ASSERT_EQ(INT32_MIN, v32);
+
+    ASSERT_TRUE(parseInt("-ff", 3, v32, 16));
+    ASSERT_EQ(-255, v32);
+
+    const char* sign = "-x";
+    ASSERT_EQ(peNoDigits, parseInt(sign, 2, v32).error);
+    ASSERT_EQ(sign, parseInt(sign, 2, v32).end);
+    ASSERT_EQ(peNoDigits, parseInt("+1", 2, v32).error);
+    ASSERT_EQ(peNoDigits, parseInt(" 1", 2, v32).error);
+}
+
+TEST(IntStr, TestFormatFixed)
+{
+    char buffer[32];
+
+    ASSERT_EQ("07", std::string(buffer, formatFixed<2>(buffer, 7)));
+    ASSERT_EQ("2026", std::string(buffer, formatFixed<4>(buffer, 2026)));
+    ASSERT_EQ("0000", std::string(buffer, formatFixed<4>(buffer, 0)));
+    ASSERT_EQ("026", std::string(buffer, formatFixed<3>(buffer, 2026)));
+    ASSERT_EQ("00BE", std::string(buffer, formatFixed<4, 16>(buffer, 0xbe)));
+    ASSERT_EQ("0a", std::string(buffer, formatFixed<2, 16, '0', hcLower>(buffer, uint8_t(10))));
+    ASSERT_EQ("   42", std::string(buffer, formatFixed<5, 10, ' '>(buffer, 42)));
+    ASSERT_EQ("    0", std::string(buffer, formatFixed<5, 10, ' '>(buffer, 0)));
+    ASSERT_EQ("00000101", std::string(buffer, formatFixed<8, 2>(buffer, 5u)));
+    ASSERT_EQ("18446744073709551615", std::string(buffer, formatFixed<20>(buffer, UINT64_MAX)));
+
+    // Only the field is written
+    memset(buffer, 'x', sizeof(buffer));
+    formatFixed<2>(buffer, 5);
+    ASSERT_EQ('x', buffer[2]);
+}
+
+static std::string dtoaString(double value)
+{
+    char buffer[DoubleBufferSize];
+    return std::string(buffer, dtoa(buffer, value));
+}
+
+static std::string dtoaFixedString(double value, int precision)
+{
+    char buffer[DoubleBufferSize];
+    return std::string(buffer, dtoaFixed(buffer, value, precision));
+}
+
+TEST(DoubleStr, TestDtoa)
+{
+    ASSERT_EQ(dtoaString(0.0), "0");
+    ASSERT_EQ(dtoaString(-0.0), "-0");
+    ASSERT_EQ(dtoaString(0.1), "0.1");
+    ASSERT_EQ(dtoaString(1.5), "1.5");
+    ASSERT_EQ(dtoaString(-2.25), "-2.25");
+    ASSERT_EQ(dtoaString(100), "100");
+    ASSERT_EQ(dtoaString(123456.789), "123456.789");
+    ASSERT_EQ(dtoaString(0.000001), "0.000001");
+    ASSERT_EQ(dtoaString(1.5e-7), "1.5e-7");
+    ASSERT_EQ(dtoaString(1e20), "100000000000000000000");
+    ASSERT_EQ(dtoaString(1e21), "1e+21");
+    ASSERT_EQ(dtoaString(5e-324), "5e-324");
+    ASSERT_EQ(dtoaString(std::numeric_limits<double>::max()), "1.7976931348623157e+308");
+    ASSERT_EQ(dtoaString(std::numeric_limits<double>::min()), "2.2250738585072014e-308");
+    ASSERT_EQ(dtoaString(std::numeric_limits<double>::infinity()), "inf");
+    ASSERT_EQ(dtoaString(-std::numeric_limits<double>::infinity()), "-inf");
+    ASSERT_EQ(dtoaString(std::numeric_limits<double>::quiet_NaN()), "nan");
+}
+
+TEST(DoubleStr, TestDtoaRoundTrip)
+{
+    std::mt19937_64 random(42);
+    char printed[DoubleBufferSize];
+    int longer = 0;
+
+    for (int i = 0; i < 100000; i++)
+    {
+        uint64_t bits = random();
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        if (!std::isfinite(value))
+            continue;
+
+        const std::string str = dtoaString(value);
+        ASSERT_EQ(strtod(str.c_str(), nullptr), value) << str;
+
+        // Grisu2 misses the shortest digits when they sit right on the rounding boundary
+        std::string digits(str.begin(), std::find(str.begin(), str.end(), 'e'));
+        digits.erase(std::remove_if(digits.begin(), digits.end(), [](char c) { return !isdigit(c); }), digits.end());
+        digits.erase(0, digits.find_first_not_of('0'));
+        digits.erase(digits.find_last_not_of('0') + 1);
+
+        int precision = 1;
+        for (; precision < 17; precision++)
+        {
+            snprintf(printed, sizeof(printed), "%.*g", precision, value);
+            if (strtod(printed, nullptr) == value)
+                break;
+        }
+        ASSERT_LE(digits.size(), 17u) << str;
+        if (digits.size() > static_cast<size_t>(precision))
+            longer++;
+    }
+
+    ASSERT_LT(longer, 200);
+}
+
+TEST(DoubleStr, TestDtoaFixed)
+{
+    ASSERT_EQ(dtoaFixedString(0, 2), "0.00");
+    ASSERT_EQ(dtoaFixedString(1.5, 0), "2");
+    ASSERT_EQ(dtoaFixedString(3.14159, 3), "3.142");
+    ASSERT_EQ(dtoaFixedString(-0.004, 2), "-0.00");
+    ASSERT_EQ(dtoaFixedString(0.05, 4), "0.0500");
+    ASSERT_EQ(dtoaFixedString(1e30, 2), "1e+30");
+
+    std::mt19937_64 random(7);
+    std::uniform_real_distribution<double> distribution(-1e5, 1e5);
+    char printed[64];
+
+    for (int i = 0; i < 10000; i++)
+    {
+        const double value = distribution(random);
+        const int precision = i % 8;
+
+        snprintf(printed, sizeof(printed), "%.*f", precision, value);
+        ASSERT_EQ(dtoaFixedString(value, precision), printed);
+
+        // Multiples of 2^-10 scale exactly by 10^10, the digits must all match
+        const double dyadic = std::ldexp(std::round(std::ldexp(value, 10)), -10);
+        snprintf(printed, sizeof(printed), "%.10f", dyadic);
+        ASSERT_EQ(dtoaFixedString(dyadic, 10), printed);
+    }
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "../bf/intern.h"
+
+using namespace bitforge;
+
+TEST(Intern, CanonicalEntries)
+{
+    InternedString udp("udp");
+    InternedString udp2(std::string("udp"));
+    InternedString tcp("tcp");
+    InternedString host(NCString("streaming-server.example.com"));
+    InternedString host2("streaming-server.example.com");
+
+    ASSERT_EQ(udp, udp2);
+    ASSERT_NE(udp, tcp);
+    ASSERT_EQ(host, host2);
+    ASSERT_EQ(host.c_str(), host2.c_str());
+    ASSERT_EQ(udp.hash(), stringHash("udp", 3));
+    ASSERT_STREQ(host.c_str(), "streaming-server.example.com");
+
+    ASSERT_TRUE(InternedString().empty());
+    ASSERT_EQ(InternedString(""), InternedString());
+    ASSERT_STREQ(InternedString().c_str(), "");
+
+    std::unordered_set<InternedString> set;
+    set.insert(udp);
+    set.insert(udp2);
+    set.insert(tcp);
+    ASSERT_EQ(set.size(), 2u);
+}
+
+TEST(Intern, Threads)
+{
+    const int threadCount = 8;
+    std::vector<std::thread> threads;
+    std::vector<std::vector<InternedString>> results(threadCount);
+
+    for (int t = 0; t < threadCount; t++)
+    {
+        threads.emplace_back([t, &results]()
+        {
+            for (int i = 0; i < 1000; i++)
+                results[t].push_back(InternedString("interface-" + std::to_string(i)));
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    for (int t = 1; t < threadCount; t++)
+        ASSERT_EQ(results[t], results[0]);
+}
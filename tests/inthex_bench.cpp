@@ -0,0 +1,351 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#if (__cplusplus >= 201703L)
+#include <charconv>
+#endif
+
+#include <bf/floatfmt.h>
+#include <bf/inthex.h>
+
+using namespace bitforge;
+
+// Numbers of mixed widths, like counters and timestamps in log lines
+static const std::vector<uint64_t>& values()
+{
+    static std::vector<uint64_t> values;
+    if (values.empty())
+    {
+        std::mt19937_64 random(42);
+        for (int i = 0; i < 1024; i++)
+            values.push_back(random() >> (random() % 64));
+    }
+    return values;
+}
+
+// The one digit per division loop inthex.h used before
+static char* divisionLoop(char* buffer, const int bufferSize, uint64_t val)
+{
+    char* c = buffer + (bufferSize - 1);
+    *c = 0;
+
+    do
+    {
+        *--c = '0' + (val % 10);
+        val /= 10;
+    }
+    while(val);
+
+    return c;
+}
+
+static void DivisionLoop(benchmark::State& state)
+{
+    char buffer[32];
+
+    for (auto _ : state)
+    {
+        for (uint64_t v : values())
+            benchmark::DoNotOptimize(divisionLoop(buffer, sizeof(buffer), v));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * values().size());
+}
+BENCHMARK(DivisionLoop);
+
+static void U64toa(benchmark::State& state)
+{
+    char buffer[32];
+
+    for (auto _ : state)
+    {
+        for (uint64_t v : values())
+            benchmark::DoNotOptimize(u64toa(buffer, v));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * values().size());
+}
+BENCHMARK(U64toa);
+
+static void Uint64tostr(benchmark::State& state)
+{
+    char buffer[32];
+
+    for (auto _ : state)
+    {
+        for (uint64_t v : values())
+            benchmark::DoNotOptimize(uint64tostr(buffer, sizeof(buffer), v));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * values().size());
+}
+BENCHMARK(Uint64tostr);
+
+static void Snprintf(benchmark::State& state)
+{
+    char buffer[32];
+
+    for (auto _ : state)
+    {
+        for (uint64_t v : values())
+            benchmark::DoNotOptimize(snprintf(buffer, sizeof(buffer), "%llu", static_cast<unsigned long long>(v)));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * values().size());
+}
+BENCHMARK(Snprintf);
+
+#if (__cplusplus >= 201703L)
+static void ToChars(benchmark::State& state)
+{
+    char buffer[32];
+
+    for (auto _ : state)
+    {
+        for (uint64_t v : values())
+            benchmark::DoNotOptimize(std::to_chars(buffer, buffer + sizeof(buffer), v).ptr);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * values().size());
+}
+BENCHMARK(ToChars);
+#endif
+
+// A full MPEG-TS over UDP datagram, 7 * 188 bytes
+static const std::vector<uint8_t>& datagram()
+{
+    static std::vector<uint8_t> datagram;
+    if (datagram.empty())
+    {
+        std::mt19937 random(42);
+        for (int i = 0; i < 1316; i++)
+            datagram.push_back(random());
+    }
+    return datagram;
+}
+
+static void HexDumpPerByteSnprintf(benchmark::State& state)
+{
+    char hex[2 * 1316 + 1];
+
+    for (auto _ : state)
+    {
+        char* c = hex;
+        for (uint8_t b : datagram())
+            c += snprintf(c, 3, "%02X", b);
+        benchmark::DoNotOptimize(hex);
+    }
+    state.SetBytesProcessed(state.iterations() * datagram().size());
+}
+BENCHMARK(HexDumpPerByteSnprintf);
+
+static void HexDumpBytesToHex(benchmark::State& state)
+{
+    char hex[2 * 1316];
+
+    for (auto _ : state)
+    {
+        bytesToHex(hex, datagram().data(), datagram().size());
+        benchmark::DoNotOptimize(hex);
+    }
+    state.SetBytesProcessed(state.iterations() * datagram().size());
+}
+BENCHMARK(HexDumpBytesToHex);
+
+static void HexDecodeHexToBytes(benchmark::State& state)
+{
+    char hex[2 * 1316];
+    uint8_t bytes[1316];
+    bytesToHex(hex, datagram().data(), datagram().size());
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(hexToBytes(bytes, hex, sizeof(hex)));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * datagram().size());
+}
+BENCHMARK(HexDecodeHexToBytes);
+
+// The values() above as text, separated by spaces
+static const std::string& valueText()
+{
+    static std::string text;
+    if (text.empty())
+    {
+        for (uint64_t v : values())
+            text += std::to_string(v) + " ";
+    }
+    return text;
+}
+
+static void ParseStrtoull(benchmark::State& state)
+{
+    const std::string& text = valueText();
+
+    for (auto _ : state)
+    {
+        const char* p = text.c_str();
+        char* end;
+        for (std::size_t i = 0; i < values().size(); i++, p = end + 1)
+            benchmark::DoNotOptimize(strtoull(p, &end, 10));
+    }
+    state.SetItemsProcessed(state.iterations() * values().size());
+}
+BENCHMARK(ParseStrtoull);
+
+static void ParseUint(benchmark::State& state)
+{
+    const std::string& text = valueText();
+    const char* end = text.data() + text.size();
+
+    for (auto _ : state)
+    {
+        const char* p = text.data();
+        uint64_t v;
+        for (std::size_t i = 0; i < values().size(); i++)
+        {
+            p = parseUint(p, end - p, v).end + 1;
+            benchmark::DoNotOptimize(v);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * values().size());
+}
+BENCHMARK(ParseUint);
+
+#if (__cplusplus >= 201703L)
+static void ParseFromChars(benchmark::State& state)
+{
+    const std::string& text = valueText();
+    const char* end = text.data() + text.size();
+
+    for (auto _ : state)
+    {
+        const char* p = text.data();
+        uint64_t v;
+        for (std::size_t i = 0; i < values().size(); i++)
+        {
+            p = std::from_chars(p, end, v).ptr + 1;
+            benchmark::DoNotOptimize(v);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * values().size());
+}
+BENCHMARK(ParseFromChars);
+#endif
+
+// Doubles from the whole range and timings-like ones with a few decimals
+static const std::vector<double>& doubles()
+{
+    static std::vector<double> values;
+    if (values.empty())
+    {
+        std::mt19937_64 random(42);
+        std::uniform_real_distribution<double> seconds(0, 1000);
+        while (values.size() < 1024)
+        {
+            uint64_t bits = random();
+            double value;
+            memcpy(&value, &bits, sizeof(value));
+            if (std::isfinite(value))
+                values.push_back(value);
+            values.push_back(std::round(seconds(random) * 100) / 100);
+        }
+    }
+    return values;
+}
+
+static void Dtoa(benchmark::State& state)
+{
+    char buffer[DoubleBufferSize];
+
+    for (auto _ : state)
+    {
+        for (double v : doubles())
+            benchmark::DoNotOptimize(dtoa(buffer, v));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * doubles().size());
+}
+BENCHMARK(Dtoa);
+
+static void DtoaFixed(benchmark::State& state)
+{
+    char buffer[DoubleBufferSize];
+
+    for (auto _ : state)
+    {
+        for (double v : doubles())
+            benchmark::DoNotOptimize(dtoaFixed(buffer, v, 3));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * doubles().size());
+}
+BENCHMARK(DtoaFixed);
+
+// Loses digits, shown for its speed only
+static void SnprintfG(benchmark::State& state)
+{
+    char buffer[DoubleBufferSize];
+
+    for (auto _ : state)
+    {
+        for (double v : doubles())
+            benchmark::DoNotOptimize(snprintf(buffer, sizeof(buffer), "%g", v));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * doubles().size());
+}
+BENCHMARK(SnprintfG);
+
+// What round trips with printf
+static void Snprintf17G(benchmark::State& state)
+{
+    char buffer[DoubleBufferSize];
+
+    for (auto _ : state)
+    {
+        for (double v : doubles())
+            benchmark::DoNotOptimize(snprintf(buffer, sizeof(buffer), "%.17g", v));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * doubles().size());
+}
+BENCHMARK(Snprintf17G);
+
+static void SnprintfFixed(benchmark::State& state)
+{
+    char buffer[400];
+
+    for (auto _ : state)
+    {
+        for (double v : doubles())
+            benchmark::DoNotOptimize(snprintf(buffer, sizeof(buffer), "%.3f", v));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * doubles().size());
+}
+BENCHMARK(SnprintfFixed);
+
+static void Ostream(benchmark::State& state)
+{
+    std::ostringstream out;
+
+    for (auto _ : state)
+    {
+        for (double v : doubles())
+        {
+            out.str(std::string());
+            out << v;
+        }
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetItemsProcessed(state.iterations() * doubles().size());
+}
+BENCHMARK(Ostream);
@@ -4,6 +4,23 @@
 
 using namespace bitforge;
 
+TEST(Logs, Prefix)
+{
+    std::stringstream out;
+    std::streambuf* old = std::clog.rdbuf(out.rdbuf());
+    log_info("Info");
+    std::clog.rdbuf(old);
+
+    // - YYYYMMDDTHHMMSS INFO    :
+    const std::string line = out.str();
+    ASSERT_GT(line.size(), 27u);
+    ASSERT_EQ("- ", line.substr(0, 2));
+    for (int i : { 2, 3, 4, 5, 6, 7, 8, 9, 11, 12, 13, 14, 15, 16 })
+        ASSERT_TRUE(isdigit(line[i])) << line;
+    ASSERT_EQ('T', line[10]);
+    ASSERT_EQ(" INFO    :", line.substr(17, 10));
+}
+
 TEST(Logs, Syslog)
 {
     Log::useSysLog("TestLog");
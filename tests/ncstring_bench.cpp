@@ -0,0 +1,106 @@
+#include <benchmark/benchmark.h>
+
+#include <bf/arena.h>
+#include <bf/io/net/bfsocket.h>
+
+using namespace bitforge;
+
+static void ServiceAddressConstruct(benchmark::State& state)
+{
+    const std::string url("udp://239.255.255.250:1900");
+
+    for (auto _ : state)
+    {
+        ServiceAddress address(url);
+        benchmark::DoNotOptimize(address);
+    }
+}
+BENCHMARK(ServiceAddressConstruct);
+
+static void ServiceAddressCopy(benchmark::State& state)
+{
+    const ServiceAddress address("http://192.168.0.1:8080/stream/channel/1");
+
+    for (auto _ : state)
+    {
+        ServiceAddress copy(address);
+        benchmark::DoNotOptimize(copy);
+    }
+}
+BENCHMARK(ServiceAddressCopy);
+
+static void NCStringShortCopy(benchmark::State& state)
+{
+    const NCString str("udp");
+
+    for (auto _ : state)
+    {
+        NCString copy(str);
+        benchmark::DoNotOptimize(copy);
+    }
+}
+BENCHMARK(NCStringShortCopy);
+
+static void NCStringLongCopy(benchmark::State& state)
+{
+    const NCString str("http://192.168.0.1:8080/stream/channel/1");
+
+    for (auto _ : state)
+    {
+        NCString copy(str);
+        benchmark::DoNotOptimize(copy);
+    }
+}
+BENCHMARK(NCStringLongCopy);
+
+static void LocalNCStringLongCopy(benchmark::State& state)
+{
+    const LocalNCString str("http://192.168.0.1:8080/stream/channel/1");
+
+    for (auto _ : state)
+    {
+        LocalNCString copy(str);
+        benchmark::DoNotOptimize(copy);
+    }
+}
+BENCHMARK(LocalNCStringLongCopy);
+
+static void NCStringLongConstruct(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        NCString str("http://192.168.0.1:8080/stream/channel/1");
+        benchmark::DoNotOptimize(str);
+    }
+}
+BENCHMARK(NCStringLongConstruct);
+
+static void ArenaNCStringLongConstruct(benchmark::State& state)
+{
+    Arena arena;
+
+    for (auto _ : state)
+    {
+        Arena::Scope scope(arena);
+        ArenaNCString str("http://192.168.0.1:8080/stream/channel/1");
+        benchmark::DoNotOptimize(str);
+
+        if (arena.allocated() > 32 * 1024)
+            arena.reset();
+    }
+}
+BENCHMARK(ArenaNCStringLongConstruct);
+
+static void ArenaNCStringLongCopy(benchmark::State& state)
+{
+    Arena arena;
+    Arena::Scope scope(arena);
+    const ArenaNCString str("http://192.168.0.1:8080/stream/channel/1");
+
+    for (auto _ : state)
+    {
+        ArenaNCString copy(str);
+        benchmark::DoNotOptimize(copy);
+    }
+}
+BENCHMARK(ArenaNCStringLongCopy);
@@ -0,0 +1,394 @@
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <new>
+#include <unordered_map>
+
+#include "../bf/ncstring.h"
+#include "../bf/ncstringbuilder.h"
+#include "../bf/arena.h"
+#include "../bf/io/net/bfsocket.h"
+
+using namespace bitforge;
+
+// Count heap allocations made by the current thread
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+static thread_local std::size_t s_allocations = 0;
+
+void* operator new(std::size_t size)
+{
+    s_allocations++;
+
+    void* ptr = malloc(size ? size : 1);
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    free(ptr);
+}
+
+class AllocationCounter
+{
+private:
+    std::size_t m_start;
+
+public:
+    AllocationCounter(): m_start(s_allocations) {}
+
+    std::size_t count() const { return s_allocations - m_start; }
+};
+
+TEST(NCString, ShortStringsDoNotAllocate)
+{
+    char longest[NCString::InlineCapacity + 1];
+    memset(longest, 'x', NCString::InlineCapacity);
+    longest[NCString::InlineCapacity] = 0;
+
+    AllocationCounter counter;
+
+    NCString udp("udp");
+    NCString copy(udp);
+    NCString assigned;
+    assigned = copy;
+    NCString moved(std::move(copy));
+    NCString maxInline(longest);
+
+    ASSERT_EQ(counter.count(), 0u);
+
+    ASSERT_STREQ(udp.c_str(), "udp");
+    ASSERT_STREQ(assigned.c_str(), "udp");
+    ASSERT_STREQ(moved.c_str(), "udp");
+    ASSERT_EQ(maxInline.length(), NCString::InlineCapacity);
+}
+
+TEST(NCString, LongStringsShareMemory)
+{
+    const char* text = "udp://239.255.255.250:1900/some/long/query";
+
+    NCString str(text);
+
+    AllocationCounter counter;
+
+    NCString copy(str);
+    NCString assigned;
+    assigned = str;
+
+    ASSERT_EQ(counter.count(), 0u);
+    ASSERT_EQ(copy.data(), str.data());
+    ASSERT_EQ(assigned.data(), str.data());
+    ASSERT_STREQ(copy.c_str(), text);
+}
+
+TEST(NCString, AppendAndChop)
+{
+    NCString str("udp");
+    str.append("://239.255.255.250:1900");
+    ASSERT_STREQ(str.c_str(), "udp://239.255.255.250:1900");
+
+    NCString copy(str);
+    copy.chop(3);
+    ASSERT_STREQ(copy.c_str(), "udp");
+    ASSERT_STREQ(str.c_str(), "udp://239.255.255.250:1900");
+
+    str.chop(6);
+    ASSERT_STREQ(str.c_str(), "udp://");
+}
+
+TEST(NCString, LongStringsUseOneAllocation)
+{
+    const char* text = "http://192.168.0.1:8080/stream/channel/1";
+
+    AllocationCounter counter;
+
+    NCString str(text);
+    ASSERT_EQ(counter.count(), 1u);
+
+    LocalNCString local(text);
+    ASSERT_EQ(counter.count(), 2u);
+
+    LocalNCString localCopy(local);
+    ASSERT_EQ(counter.count(), 2u);
+    ASSERT_EQ(localCopy.data(), local.data());
+    ASSERT_STREQ(localCopy.c_str(), text);
+}
+
+TEST(NCString, HeapMemoryObject)
+{
+    const char* text = "http://192.168.0.1:8080/stream/channel/1";
+
+    BasicNCString<BasicMemoryObject> str(text);
+    BasicNCString<BasicMemoryObject> copy(str);
+
+    ASSERT_EQ(copy.data(), str.data());
+    ASSERT_STREQ(copy.c_str(), text);
+}
+
+TEST(NCString, SubstrSharesBuffer)
+{
+    NCString str("http://192.168.0.1:8080/stream/channel/1");
+
+    AllocationCounter counter;
+
+    NCString tail = str.substr(7);
+    NCString host = str.substr(7, 11);
+    NCString middle = str.substr(0, 30);
+
+    ASSERT_EQ(counter.count(), 0u);
+    ASSERT_EQ(tail.data(), str.data() + 7);
+    ASSERT_EQ(middle.data(), str.data());
+    ASSERT_STREQ(tail.c_str(), "192.168.0.1:8080/stream/channel/1");
+    ASSERT_STREQ(host.c_str(), "192.168.0.1");
+    ASSERT_EQ(counter.count(), 0u);
+
+    // Terminating a view that ends before the buffer does takes a copy
+    ASSERT_STREQ(middle.c_str(), "http://192.168.0.1:8080/stream");
+    ASSERT_EQ(counter.count(), 1u);
+    ASSERT_STREQ(str.c_str(), "http://192.168.0.1:8080/stream/channel/1");
+
+    ASSERT_TRUE(str.substr(str.length()).empty());
+    ASSERT_STREQ(str.substr(str.length()).c_str(), "");
+}
+
+TEST(NCString, ServiceAddressParseDoesNotAllocate)
+{
+    NCString url("udp://239.255.255.250:1900/some/long/query/path");
+
+    AllocationCounter counter;
+
+    ServiceAddress address(url);
+
+    ASSERT_EQ(counter.count(), 0u);
+    ASSERT_EQ(address.socketType(), ServiceAddress::stUDP);
+    ASSERT_EQ(address.port(), 1900);
+    ASSERT_STREQ(address.protocol().c_str(), "udp");
+    ASSERT_STREQ(address.host().c_str(), "239.255.255.250");
+    ASSERT_STREQ(address.query().c_str(), "/some/long/query/path");
+
+    ASSERT_EQ(ServiceAddress(NCString("tcp://10.0.0.1:8080")).port(), 8080);
+    ASSERT_NO_THROW(ServiceAddress(NCString("tcp://10.0.0.1:65535")));
+    ASSERT_THROW(ServiceAddress(NCString("tcp://10.0.0.1:65536")), SocketAddrerssException);
+    ASSERT_THROW(ServiceAddress(NCString("tcp://10.0.0.1:80x/path")), SocketAddrerssException);
+    ASSERT_THROW(ServiceAddress(NCString("tcp://10.0.0.1:/path")), SocketAddrerssException);
+}
+
+TEST(NCString, HashIsCached)
+{
+    const char* text = "http://192.168.0.1:8080/stream/channel/1";
+
+    NCString str(text);
+    NCString copy(str);
+
+    ASSERT_EQ(str.hash(), stringHash(text, strlen(text)));
+    ASSERT_EQ(copy.hash(), str.hash());
+    ASSERT_EQ(std::hash<NCString>()(str), str.hash());
+    ASSERT_EQ(NCString("udp").hash(), stringHash("udp", 3));
+
+    // Views and modified strings don't reuse the cached value
+    ASSERT_EQ(str.substr(0, 30).hash(), stringHash(text, 30));
+
+    NCString appended(str);
+    appended.append("/2");
+    ASSERT_EQ(appended.hash(), stringHash(appended.data(), appended.length()));
+    ASSERT_EQ(str.hash(), stringHash(text, strlen(text)));
+}
+
+TEST(NCString, HeterogeneousLookup)
+{
+    std::unordered_map<NCString, int, NCStringHash, NCStringEqual> map;
+    map["udp"] = 1;
+    map["streaming-server.example.com/channel"] = 2;
+
+    const char* buffer = "streaming-server.example.com/channel/1";
+
+    AllocationCounter counter;
+
+    auto it = map.find(NCString::unowned(buffer, 36));
+    ASSERT_NE(it, map.end());
+    ASSERT_EQ(it->second, 2);
+    ASSERT_EQ(map.count(NCString::unowned(buffer, 3)), 0u);
+
+    ASSERT_EQ(counter.count(), 0u);
+
+    ASSERT_TRUE(NCStringEqual()(it->first, StringView(buffer, 36)));
+    ASSERT_EQ(NCStringHash()(it->first), NCStringHash()(StringView(buffer, 36)));
+
+    // Keys copied out of an unowned string own their memory
+    NCString unowned = NCString::unowned(buffer, 6);
+    NCString key(unowned);
+    ASSERT_NE(key.data(), buffer);
+    ASSERT_STREQ(key.c_str(), "stream");
+
+    StringView view = it->first;
+    ASSERT_EQ(view.size(), 36u);
+
+#if (__cplusplus >= 202002L)
+    ASSERT_NE(map.find(StringView(buffer, 36)), map.end());
+    ASSERT_NE(map.find("udp"), map.end());
+#endif
+}
+
+TEST(NCString, EqualityComparesLength)
+{
+    NCString a("abc");
+    NCString b("abcd");
+
+    ASSERT_FALSE(a == b);
+    ASSERT_FALSE(b == a);
+    ASSERT_TRUE(a != b);
+    ASSERT_TRUE(a == b.substr(0, 3));
+    ASSERT_TRUE(NCString() == NCString(""));
+
+    char withNul[] = { 'a', '\0', 'b' };
+    ASSERT_FALSE(NCString(withNul, 3) == NCString(withNul, 2));
+}
+
+TEST(NCString, SearchMatchesStdString)
+{
+    // Sizes around the 16 and 32 byte vectors, matches near block edges and in the tails
+    for (std::size_t size = 0; size < 80; size++)
+    {
+        std::string text;
+        for (std::size_t i = 0; i < size; i++)
+            text += 'a' + (i * 7) % 5;
+
+        NCString str(text.data(), text.size());
+
+        for (std::size_t pos = 0; pos <= size + 1; pos += 3)
+        {
+            for (char c : { 'a', 'c', 'e', 'z' })
+            {
+                ASSERT_EQ(text.find(c, pos), str.find(c, pos)) << size << " " << pos << " " << c;
+                ASSERT_EQ(text.rfind(c, pos), str.rfind(c, pos)) << size << " " << pos << " " << c;
+            }
+
+            for (const char* needle : { "", "ac", "ceb", "acebd", "acebdacebdaceb", "dd", "zz" })
+            {
+                ASSERT_EQ(text.find(needle, pos), str.find(needle, pos)) << size << " " << pos << " " << needle;
+                ASSERT_EQ(text.rfind(needle, pos), str.rfind(needle, pos)) << size << " " << pos << " " << needle;
+            }
+
+            for (const char* set : { "e", "de", "xyzd", "0123456789ABCDEFd", "0123456789ABCDEFGHIJ" })
+                ASSERT_EQ(text.find_first_of(set, pos), str.find_first_of(set, pos)) << size << " " << pos << " " << set;
+        }
+    }
+
+    NCString url("http://www.bitforge.com.br:8080/index.html");
+    ASSERT_EQ(4u, url.find("://"));
+    ASSERT_EQ(26u, url.rfind(':'));
+    ASSERT_EQ(4u, url.find_first_of(":/"));
+    ASSERT_EQ(31u, url.rfind("/"));
+}
+
+TEST(NCString, AppendGrowsGeometrically)
+{
+    NCString str;
+    std::string expected;
+
+    AllocationCounter counter;
+    for (int i = 0; i < 1000; i++)
+    {
+        str.append("0123456789", 10);
+        expected.append("0123456789");
+    }
+    ASSERT_LE(counter.count(), 20u);
+    ASSERT_EQ(expected, str.c_str());
+
+    NCString copy = str;
+    copy.append('!');
+    ASSERT_EQ(expected.size(), str.length());
+    ASSERT_EQ(expected + "!", copy.c_str());
+
+    str.append(str);
+    ASSERT_EQ(expected + expected, str.c_str());
+
+    NCString reserved;
+    reserved.reserve(500);
+    ASSERT_GE(reserved.capacity(), 500u);
+
+    AllocationCounter reservedCounter;
+    for (int i = 0; i < 50; i++)
+        reserved.append("0123456789");
+    ASSERT_EQ(0u, reservedCounter.count());
+}
+
+TEST(NCString, Builder)
+{
+    NCStringBuilder builder(256);
+
+    AllocationCounter counter;
+    builder << "GET /index.html HTTP/1.1\r\nContent-Length: " << 1234567u << "\r\n";
+    builder << 0 << ' ' << -42 << ' ' << INT64_MIN << ' ' << UINT64_MAX << ' ';
+    builder.appendHex(0xbeef).append(' ').appendHex(0x1f, 4).append(' ').appendHex(0xabcdef, 2);
+    ASSERT_EQ(0u, counter.count());
+
+    NCString str = builder.release();
+    ASSERT_STREQ("GET /index.html HTTP/1.1\r\nContent-Length: 1234567\r\n"
+                 "0 -42 -9223372036854775808 18446744073709551615 BEEF 001F ABCDEF", str.c_str());
+    ASSERT_EQ(0u, builder.length());
+
+    builder << "x" << 1;
+    ASSERT_EQ(NCString("x1"), builder.str());
+    builder.clear();
+    builder << 2;
+    ASSERT_EQ(NCString("2"), builder.str());
+}
+
+TEST(NCString, ArenaMemoryObject)
+{
+    const char* text = "a string that is too long to be stored inline";
+    Arena arena(16 * 1024);
+
+    {
+        Arena::Scope scope(arena);
+
+        ArenaNCString first(text);
+        ASSERT_GT(arena.allocated(), 0u);
+
+        AllocationCounter counter;
+        for (int i = 0; i < 10; i++)
+        {
+            ArenaNCString str(text);
+            ArenaNCString copy = str;
+            ArenaNCString moved = std::move(copy);
+            moved.append("!");
+            ASSERT_EQ(strlen(text) + 1, moved.length());
+            ASSERT_STREQ(text, str.c_str());
+            ASSERT_EQ(first.hash(), str.hash());
+        }
+
+        // A big string gets its own chunk
+        static char bigText[32 * 1024];
+        memset(bigText, 'x', sizeof(bigText));
+        ArenaNCString big(bigText, sizeof(bigText));
+        ASSERT_EQ(sizeof(bigText), big.length());
+        ASSERT_EQ(1u, counter.count());
+    }
+
+    // Without a scope the strings live on the heap and outlive the arena
+    ArenaNCString heap(text);
+
+    // The first reset merges the chunks, from then on the arena is reused as is
+    arena.reset();
+
+    AllocationCounter counter;
+    for (int round = 0; round < 3; round++)
+    {
+        arena.reset();
+        Arena::Scope scope(arena);
+        for (int i = 0; i < 100; i++)
+            ArenaNCString str(text);
+    }
+    ASSERT_EQ(0u, counter.count());
+
+    arena.reset();
+    ASSERT_STREQ(text, heap.c_str());
+}
@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/wait.h>
+
+#include "../bf/bf.h"
+
+using namespace bitforge;
+
+TEST(Process, Output)
+{
+    const char* const args[] = {"sh", "-c", "echo hello; echo oops >&2; exit 3", nullptr};
+    Process process(args);
+
+    ASSERT_GT(process.pid(), 0);
+    ASSERT_TRUE(fcntl(process.stdOut(), F_GETFD) & FD_CLOEXEC);
+    ASSERT_TRUE(fcntl(process.stdOut(), F_GETFL) & O_NONBLOCK);
+
+    const int status = process.wait();
+    ASSERT_TRUE(process.exited());
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(3, process.exitCode());
+    ASSERT_EQ("hello\n", process.output());
+    ASSERT_EQ("oops\n", process.errors());
+    ASSERT_EQ(-1, process.stdOut());
+    ASSERT_EQ(-1, process.pidFd());
+
+    ASSERT_EQ("hello\n", process.takeOutput());
+    ASSERT_TRUE(process.output().empty());
+}
+
+TEST(Process, Input)
+{
+    const char* const args[] = {"tr", "a-z", "A-Z", nullptr};
+    Process process(args);
+
+    const std::string text = "some text";
+    ASSERT_EQ(static_cast<ssize_t>(text.size()), write(process.stdIn(), text.data(), text.size()));
+
+    ASSERT_EQ(0, process.wait());
+    ASSERT_EQ("SOME TEXT", process.output());
+}
+
+TEST(Process, Errors)
+{
+    const char* const args[] = {"/nonexistent/program", nullptr};
+    ASSERT_THROW(Process process(args), ErrnoException);
+
+    // Not piped, inherited from us
+    const char* const trueArgs[] = {"true", nullptr};
+    Process process(trueArgs, environ, ppNone);
+    ASSERT_EQ(-1, process.stdIn());
+    ASSERT_EQ(-1, process.stdOut());
+    ASSERT_EQ(0, process.wait());
+}
+
+TEST(Process, Kill)
+{
+    const char* const args[] = {"sleep", "10", nullptr};
+    Process process(args);
+
+    ASSERT_FALSE(process.poll());
+    process.kill(SIGTERM);
+
+    const int status = process.wait();
+    ASSERT_TRUE(WIFSIGNALED(status));
+    ASSERT_EQ(SIGTERM, WTERMSIG(status));
+    ASSERT_EQ(-1, process.exitCode());
+
+    // Destroying a running process kills it
+    std::unique_ptr<Process> running(new Process(args));
+    const pid_t pid = running->pid();
+    running.reset();
+    ASSERT_NE(0, ::kill(pid, 0));
+}
+
+TEST(Process, Monitor)
+{
+    const int count = 20;
+    std::vector<std::unique_ptr<Process>> processes;
+    ProcessMonitor monitor;
+
+    for (int i = 0; i < count; i++)
+    {
+        const std::string script = "sleep 0.0" + std::to_string(i % 5) + "; echo " + std::to_string(i) + "; exit " + std::to_string(i);
+        const char* const args[] = {"sh", "-c", script.c_str(), nullptr};
+        processes.emplace_back(new Process(args));
+        monitor.add(processes.back().get());
+    }
+    ASSERT_EQ(static_cast<std::size_t>(count), monitor.size());
+
+    std::vector<Process*> exited;
+    for (int loops = 0; monitor.size() && loops < 1000; loops++)
+        monitor.wait(1000, exited);
+
+    ASSERT_EQ(0u, monitor.size());
+    ASSERT_EQ(static_cast<std::size_t>(count), exited.size());
+
+    for (int i = 0; i < count; i++)
+    {
+        ASSERT_TRUE(processes[i]->exited());
+        ASSERT_EQ(i, processes[i]->exitCode());
+        ASSERT_EQ(std::to_string(i) + "\n", processes[i]->output());
+    }
+
+    // Removing one that is still running leaves the rest alone
+    const char* const args[] = {"sleep", "10", nullptr};
+    Process sleeper(args);
+    monitor.add(&sleeper);
+    ASSERT_EQ(0u, monitor.wait(0, exited));
+    monitor.remove(&sleeper);
+    ASSERT_EQ(0u, monitor.size());
+
+    // A process destroyed while monitored takes itself out, output pending or not
+    std::unique_ptr<Process> talker(new Process(args));
+    const char* const echoArgs[] = {"echo", "unread", nullptr};
+    std::unique_ptr<Process> echo(new Process(echoArgs));
+    monitor.add(talker.get());
+    monitor.add(echo.get());
+    ASSERT_EQ(2u, monitor.size());
+
+    usleep(20000);
+    talker.reset();
+    echo.reset();
+    ASSERT_EQ(0u, monitor.size());
+    ASSERT_EQ(0u, monitor.wait(10, exited));
+}
+
+// The child exits at once but leaves a grandchild holding its stdout and stderr
+TEST(Process, MonitorGrandchild)
+{
+    const char* const args[] = {"sh", "-c", "echo start; (sleep 0.2; echo late) & exit 0", nullptr};
+    const char* const quickArgs[] = {"echo", "quick", nullptr};
+
+    Process parent(args);
+    std::unique_ptr<Process> quick(new Process(quickArgs));
+
+    ProcessMonitor monitor;
+    monitor.add(&parent);
+    monitor.add(quick.get());
+
+    std::vector<Process*> exited;
+    int loops = 0;
+    while (monitor.size() && loops < 100)
+    {
+        loops++;
+        exited.clear();
+        monitor.wait(1000, exited);
+
+        // Nothing in @exited may be touched by the monitor again
+        for (Process* process : exited)
+        {
+            if (process == quick.get())
+            {
+                ASSERT_EQ("quick\n", quick->output());
+                quick.reset();
+            }
+        }
+    }
+
+    ASSERT_EQ(0u, monitor.size());
+    ASSERT_EQ(nullptr, quick.get());
+    ASSERT_EQ("start\nlate\n", parent.output());
+    ASSERT_EQ(0, parent.exitCode());
+
+    // One wakeup per output, exit and EOF, not a spin on stale registrations
+    ASSERT_LT(loops, 10);
+}
+
+TEST(Process, runAttachedProcess)
+{
+    ProcStreams streams;
+    const char* const args[] = {"echo", "attached", nullptr};
+    ASSERT_TRUE(runAttachedProcess(&streams, args));
+
+    char buffer[64];
+    std::string output;
+    ssize_t r;
+    while ((r = read(streams.stdOut, buffer, sizeof(buffer))) > 0)
+        output.append(buffer, r);
+    ASSERT_EQ("attached\n", output);
+
+    ASSERT_TRUE(fcntl(streams.stdOut, F_GETFD) & FD_CLOEXEC);
+    while (waitpid(-1, nullptr, WNOHANG) > 0);
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include "../bf/buffers.h"
+
+#include <vector>
+
+using namespace std;
+using namespace bitforge;
+
+static vector<char> makeTestData(size_t size)
+{
+    vector<char> data(size);
+    for(size_t i = 0; i < size; i++)
+        data[i] = static_cast<char>((i * 131) ^ (i >> 8));
+    return data;
+}
+
+TEST(Buffers, SimpleBufferSpill)
+{
+    auto pool = make_shared<MemoryPool>(1, 4096);
+    SimpleBuffer<char> buffer(pool);
+    buffer.setSpillThreshold(4 * 4096);
+
+    auto data = makeTestData(64 * 1024 + 123);
+    buffer.append(data.data(), data.size());
+
+    ASSERT_EQ(buffer.size(), data.size());
+    ASSERT_GT(buffer.spilledPages(), 0u);
+    ASSERT_LE(buffer.residentSize(), 4u * 4096);
+
+    vector<char> out;
+    for(auto it = buffer.begin(); it != buffer.end(); it++)
+        out.insert(out.end(), it.data, it.data + it.size);
+
+    ASSERT_EQ(out, data);
+
+    vector<char> peeked(data.size());
+    ASSERT_EQ(buffer.peek(peeked.data(), peeked.size()), data.size());
+    ASSERT_EQ(peeked, data);
+}
+
+TEST(Buffers, SimpleBufferNoSpill)
+{
+    auto pool = make_shared<MemoryPool>(1, 4096);
+    SimpleBuffer<char> buffer(pool);
+
+    auto data = makeTestData(32 * 1024);
+    buffer.append(data.data(), data.size());
+
+    ASSERT_EQ(buffer.spilledPages(), 0u);
+
+    vector<char> out;
+    for(auto it = buffer.begin(); it != buffer.end(); it++)
+        out.insert(out.end(), it.data, it.data + it.size);
+
+    ASSERT_EQ(out, data);
+}
+
+TEST(Buffers, SimpleBufferFletcher32)
+{
+    auto pool = make_shared<MemoryPool>(1, 4096);
+    SimpleBuffer<char> buffer(pool);
+    buffer.setSpillThreshold(2 * 4096);
+
+    // Odd page split points, some pages spilled
+    auto data = makeTestData(5 * 4096 + 77);
+    buffer.append(data.data(), 4095);
+    buffer.append(data.data() + 4095, data.size() - 4095);
+
+    ASSERT_EQ(Fletcher32().update(buffer).finalize(), fletcher32(data.data(), data.size()));
+}
+
+// Stands in for a socket: what is spliced to it is read back from a second pipe
+class PipeSink
+{
+private:
+    int m_fds[2];
+
+public:
+    vector<char> received;
+
+    struct Fd
+    {
+        int fd;
+        int get() const { return fd; }
+    };
+
+    PipeSink() { EXPECT_EQ(0, pipe(m_fds)); }
+    ~PipeSink() { close(m_fds[0]); close(m_fds[1]); }
+
+    Fd fileDescriptor() const { return Fd{ m_fds[1] }; }
+
+    ssize_t spliceWrite(int fd, size_t size)
+    {
+        const ssize_t res = splice(fd, nullptr, m_fds[1], nullptr, size, 0);
+        if (res > 0)
+        {
+            const size_t old = received.size();
+            received.resize(old + res);
+            EXPECT_EQ(res, read(m_fds[0], &received[old], res));
+        }
+        return res;
+    }
+};
+
+TEST(Buffers, SimpleBufferSpillReuse)
+{
+    auto pool = make_shared<MemoryPool>(1, 4096);
+    SimpleBuffer<char> buffer(pool);
+    buffer.setSpillThreshold(2 * 4096);
+
+    PipeSink sink;
+    vector<char> sent;
+    off_t fileSize = 0;
+
+    for (int round = 0; round < 10; round++)
+    {
+        auto data = makeTestData(8 * 4096 + 123);
+        data[0] = static_cast<char>(round);
+        buffer.append(data.data(), data.size());
+        ASSERT_GT(buffer.spilledPages(), 0u);
+        sent.insert(sent.end(), data.begin(), data.end());
+
+        ASSERT_EQ(data.size(), buffer.spliceTo(sink));
+        ASSERT_EQ(0u, buffer.size());
+
+        // Drained slots are reused, the file doesn't grow after the first round
+        if (round == 0)
+            fileSize = buffer.spillFileSize();
+        ASSERT_GT(fileSize, 0);
+        ASSERT_EQ(fileSize, buffer.spillFileSize());
+    }
+
+    ASSERT_EQ(sent, sink.received);
+}
@@ -0,0 +1,141 @@
+#include <benchmark/benchmark.h>
+
+#include <ctime>
+
+#include <bf/histogram.h>
+#include <bf/timer.h>
+#include <bf/timestamp.h>
+#include <bf/bf.h>
+
+using namespace bitforge;
+
+static void ClockGettimeMonotonic(benchmark::State& state)
+{
+    struct timespec ts;
+
+    for (auto _ : state)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        benchmark::DoNotOptimize(ts);
+    }
+}
+BENCHMARK(ClockGettimeMonotonic);
+
+static void ClockGettimeRealtime(benchmark::State& state)
+{
+    struct timespec ts;
+
+    for (auto _ : state)
+    {
+        clock_gettime(CLOCK_REALTIME, &ts);
+        benchmark::DoNotOptimize(ts);
+    }
+}
+BENCHMARK(ClockGettimeRealtime);
+
+static void MonotonicTicks(benchmark::State& state)
+{
+    for (auto _ : state)
+        benchmark::DoNotOptimize(MonotonicClock::ticks());
+    state.SetLabel(MonotonicClock::isTsc() ? "tsc" : "clock_gettime");
+}
+BENCHMARK(MonotonicTicks);
+
+static void MonotonicNow(benchmark::State& state)
+{
+    for (auto _ : state)
+        benchmark::DoNotOptimize(MonotonicClock::now());
+}
+BENCHMARK(MonotonicNow);
+
+// A whole sample: start and end ticks and the conversion
+static void ScopedTimerSample(benchmark::State& state)
+{
+    int64_t total = 0;
+
+    for (auto _ : state)
+    {
+        ScopedTimer timer(total);
+    }
+    benchmark::DoNotOptimize(total);
+}
+BENCHMARK(ScopedTimerSample);
+
+static LatencyHistogram& histogram()
+{
+    static LatencyHistogram s_histogram;
+    return s_histogram;
+}
+
+// Every thread records into its own shard of the same histogram
+static void HistogramRecord(benchmark::State& state)
+{
+    uint64_t value = 1000 + state.thread_index();
+
+    for (auto _ : state)
+    {
+        histogram().record(value);
+        value = value * 1103515245 % 1000003;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(HistogramRecord)->Threads(1)->Threads(4);
+
+static void LatencyRecorderSample(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        LatencyRecorder recorder(histogram());
+    }
+}
+BENCHMARK(LatencyRecorderSample);
+
+static void HistogramSnapshotPercentiles(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        const HistogramSnapshot snapshot = histogram().snapshot();
+        benchmark::DoNotOptimize(snapshot.percentile(50) + snapshot.percentile(99) + snapshot.percentile(99.9));
+    }
+}
+BENCHMARK(HistogramSnapshotPercentiles);
+
+// What getDate did per call before the cache
+static void TimestampGmtime(benchmark::State& state)
+{
+    char buffer[32];
+
+    for (auto _ : state)
+    {
+        const time_t t = time(nullptr);
+        struct tm tm;
+        gmtime_r(&t, &tm);
+        benchmark::DoNotOptimize(formatDateTime(buffer, tm, '-', ' ', ':'));
+    }
+}
+BENCHMARK(TimestampGmtime);
+
+static void TimestampLocaltime(benchmark::State& state)
+{
+    char buffer[32];
+
+    for (auto _ : state)
+    {
+        const time_t t = time(nullptr);
+        struct tm tm;
+        localtime_r(&t, &tm);
+        benchmark::DoNotOptimize(formatDateTime(buffer, tm, 0, 'T', 0));
+    }
+}
+BENCHMARK(TimestampLocaltime)->Threads(1)->Threads(4);
+
+static void TimestampCached(benchmark::State& state)
+{
+    static TimestampCache s_cache(TimestampCache::tzLocal, 0, 'T', 0);
+    char buffer[TimestampCache::MaxLength];
+    const TimestampPrecision precision = static_cast<TimestampPrecision>(state.range(0));
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(s_cache.format(buffer, precision));
+}
+BENCHMARK(TimestampCached)->Arg(tpSeconds)->Arg(tpMilliseconds)->Arg(tpMicroseconds)->Threads(1)->Threads(4);
@@ -1,8 +1,17 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstring>
+#include <fstream>
 #include <limits>
+#include <sstream>
+#include <thread>
+#include <vector>
 
 #include "../bf/bf.h"
+#include "../bf/histogram.h"
+
+#include <sys/stat.h>
 
 using namespace bitforge;
 
@@ -13,6 +22,338 @@ TEST(Util, TestFletcher32)
     ASSERT_EQ(fletcher32(testData, sizeof(testData)), 1205661521);
 }
 
+// The original scalar loop
+static uint32_t fletcher32Reference(const char *data, std::size_t len)
+{
+    uint32_t sum1 = 0xffff, sum2 = 0xffff;
+    len /= 2;
+
+    while (len)
+    {
+        unsigned tlen = len > 360 ? 360 : len;
+        len -= tlen;
+        do
+        {
+            uint16_t word;
+            memcpy(&word, data, 2);
+            data += 2;
+            sum1 += word;
+            sum2 += sum1;
+        }
+        while (--tlen);
+
+        sum1 = (sum1 & 0xffff) + (sum1 >> 16);
+        sum2 = (sum2 & 0xffff) + (sum2 >> 16);
+    }
+
+    sum1 = (sum1 & 0xffff) + (sum1 >> 16);
+    sum2 = (sum2 & 0xffff) + (sum2 >> 16);
+    return sum2 << 16 | sum1;
+}
+
+TEST(Util, TestFletcher32Bulk)
+{
+    std::vector<char> data(20000);
+    unsigned seed = 1;
+    for (char& c : data)
+        c = static_cast<char>((seed = seed * 1103515245 + 12345) >> 16);
+
+    // Lengths around the vector and block sizes, odd and unaligned
+    for (std::size_t offset = 0; offset < 4; offset++)
+        for (std::size_t len = 0; len < 200; len++)
+            ASSERT_EQ(fletcher32(data.data() + offset, len), fletcher32Reference(data.data() + offset, len)) << offset << " " << len;
+
+    for (std::size_t len : { 5759, 5760, 5761, 11520, 11521, 19996 })
+        ASSERT_EQ(fletcher32(data.data() + 3, len), fletcher32Reference(data.data() + 3, len)) << len;
+
+    // Sums hitting 0 modulo 65535
+    std::vector<char> ones(20000, '\xff');
+    for (std::size_t len : { 0, 1, 2, 3, 64, 720, 721, 20000 })
+        ASSERT_EQ(fletcher32(ones.data(), len), fletcher32Reference(ones.data(), len)) << len;
+}
+
+TEST(Util, TestFletcher32Incremental)
+{
+    std::vector<char> data(10000);
+    for (std::size_t i = 0; i < data.size(); i++)
+        data[i] = static_cast<char>(i * 7 + (i >> 5));
+
+    const uint32_t expected = fletcher32(data.data(), data.size());
+
+    for (std::size_t chunk : { 1, 2, 3, 7, 64, 333, 4096 })
+    {
+        Fletcher32 state;
+        for (std::size_t pos = 0; pos < data.size(); pos += chunk)
+            state.update(data.data() + pos, std::min(chunk, data.size() - pos));
+        ASSERT_EQ(state.finalize(), expected) << chunk;
+    }
+
+    // The last odd byte doesn't count
+    ASSERT_EQ(Fletcher32().update(data.data(), 101).finalize(), fletcher32(data.data(), 100));
+    ASSERT_EQ(Fletcher32().update("a", 1).finalize(), 0xffffffffu);
+}
+
+// Bit at a time references
+static uint32_t crc32cReference(const uint8_t* data, std::size_t len)
+{
+    uint32_t crc = 0xffffffff;
+    while (len--)
+    {
+        crc ^= *data++;
+        for (int bit = 0; bit < 8; bit++)
+            crc = (crc >> 1) ^ (crc & 1 ? 0x82f63b78 : 0);
+    }
+    return ~crc;
+}
+
+static uint32_t crc32Mpeg2Reference(const uint8_t* data, std::size_t len)
+{
+    uint32_t crc = 0xffffffff;
+    while (len--)
+    {
+        crc ^= static_cast<uint32_t>(*data++) << 24;
+        for (int bit = 0; bit < 8; bit++)
+            crc = (crc << 1) ^ (crc & 0x80000000 ? 0x04c11db7 : 0);
+    }
+    return crc;
+}
+
+TEST(Util, TestCrc)
+{
+    ASSERT_EQ(crc32c("123456789", 9), 0xe3069283u);
+    ASSERT_EQ(crc32Mpeg2("123456789", 9), 0x0376e6e7u);
+    ASSERT_EQ(crc32c("", 0), 0u);
+    ASSERT_EQ(crc32Mpeg2("", 0), 0xffffffffu);
+
+    std::vector<uint8_t> data(5000);
+    unsigned seed = 3;
+    for (uint8_t& c : data)
+        c = static_cast<uint8_t>((seed = seed * 1103515245 + 12345) >> 16);
+
+    // Lengths around the folding and word sizes, unaligned
+    for (std::size_t offset = 0; offset < 8; offset += 3)
+    {
+        for (std::size_t len = 0; len < 300; len++)
+        {
+            ASSERT_EQ(crc32c(data.data() + offset, len), crc32cReference(data.data() + offset, len)) << len;
+            ASSERT_EQ(crc32Mpeg2(data.data() + offset, len), crc32Mpeg2Reference(data.data() + offset, len)) << len;
+        }
+    }
+    ASSERT_EQ(crc32Mpeg2(data.data() + 1, 4999), crc32Mpeg2Reference(data.data() + 1, 4999));
+
+    for (std::size_t chunk : { 1, 5, 64, 129, 1000 })
+    {
+        Crc32c c;
+        Crc32Mpeg2 m;
+        for (std::size_t pos = 0; pos < data.size(); pos += chunk)
+        {
+            c.update(data.data() + pos, std::min(chunk, data.size() - pos));
+            m.update(data.data() + pos, std::min(chunk, data.size() - pos));
+        }
+        ASSERT_EQ(c.finalize(), crc32c(data.data(), data.size()));
+        ASSERT_EQ(m.finalize(), crc32Mpeg2(data.data(), data.size()));
+    }
+
+    // A PSI section with its CRC_32 appended checks to 0
+    std::vector<uint8_t> section(data.begin(), data.begin() + 183);
+    const uint32_t crc = crc32Mpeg2(section.data(), section.size());
+    for (int shift = 24; shift >= 0; shift -= 8)
+        section.push_back(static_cast<uint8_t>(crc >> shift));
+    ASSERT_EQ(crc32Mpeg2(section.data(), section.size()), 0u);
+}
+
+TEST(Util, TestHash64)
+{
+    ASSERT_EQ(hash64("", 0), 0xef46db3751d8e999ull);
+    ASSERT_EQ(hash64("a", 1), 0xd24ec4f1a98c6e5bull);
+    ASSERT_EQ(hash64("abc", 3), 0x44bc2cf5ad770999ull);
+
+    const char text[] = "Nobody inspects the spammish repetition";
+    ASSERT_EQ(hash64(text, sizeof(text) - 1), 0xfbcea83c8a378bf1ull);
+    ASSERT_NE(hash64(text, sizeof(text) - 1, 1), hash64(text, sizeof(text) - 1));
+
+    std::vector<char> data(1000);
+    for (std::size_t i = 0; i < data.size(); i++)
+        data[i] = static_cast<char>(i * 31 + (i >> 3));
+
+    for (std::size_t chunk : { 1, 7, 31, 32, 33, 500 })
+    {
+        for (std::size_t len : { 0, 20, 32, 100, 1000 })
+        {
+            Hash64 hash(42);
+            for (std::size_t pos = 0; pos < len; pos += chunk)
+                hash.update(data.data() + pos, std::min(chunk, len - pos));
+            ASSERT_EQ(hash.finalize(), hash64(data.data(), len, 42)) << chunk << " " << len;
+        }
+    }
+}
+
+TEST(Util, MonotonicClock)
+{
+    const int64_t start = MonotonicClock::now();
+    const ProcTimer startTimer;
+    int64_t scoped = 0;
+
+    {
+        ScopedTimer timer(scoped);
+        usleep(20000);
+        ASSERT_GE(timer.elapsed(), 19000000);
+    }
+
+    const ProcTimer elapsed = ProcTimer() - startTimer;
+    const int64_t end = MonotonicClock::now();
+
+    ASSERT_GE(scoped, 19000000);
+    ASSERT_LT(scoped, 1000000000);
+    ASSERT_GE(elapsed.nanoseconds(), scoped);
+    ASSERT_GE(end - start, elapsed.nanoseconds());
+    ASSERT_NEAR(elapsed.seconds(), elapsed.nanoseconds() / 1e9, 1e-9);
+    ASSERT_FALSE(elapsed > 1);
+    ASSERT_GT(MonotonicClock::ticksPerSecond(), 0u);
+
+    // Always two decimals, never "0.1" or "1e-05"
+    std::ostringstream text;
+    text << elapsed;
+    ASSERT_EQ(4u, text.str().size()) << text.str();
+    ASSERT_EQ("0.", text.str().substr(0, 2));
+
+    // A TSC too slow to use falls back to clock_gettime() for both ends of an interval
+    const MonotonicClock::Calibration fallback = MonotonicClock::calibrate(UINT64_MAX);
+    ASSERT_FALSE(fallback.tsc);
+    ASSERT_FALSE(fallback.rdtscp);
+    ASSERT_EQ(uint64_t(1) << 32, fallback.multiplier);
+    ASSERT_EQ(1000000000u, fallback.ticksPerSecond);
+
+    const MonotonicClock::Calibration calibration = MonotonicClock::calibrate();
+    ASSERT_TRUE(calibration.tsc || !calibration.rdtscp);
+    ASSERT_EQ(MonotonicClock::isTsc(), calibration.tsc);
+
+    int64_t previous = MonotonicClock::now();
+    for (int i = 0; i < 10000; i++)
+    {
+        const int64_t now = MonotonicClock::now();
+        ASSERT_GE(now, previous);
+        previous = now;
+    }
+}
+
+TEST(Util, HistogramBuckets)
+{
+    ASSERT_EQ(histogramBucket(0), 0u);
+    ASSERT_EQ(histogramBucket(31), 31u);
+    ASSERT_EQ(histogramBucket(32), 32u);
+    ASSERT_EQ(histogramBucket(std::numeric_limits<uint64_t>::max()), HistogramBuckets - 1);
+
+    for (uint64_t value = 1; value && value < (1ull << 62); value = value * 3 / 2 + 1)
+    {
+        for (uint64_t v : { value - 1, value, value + 1 })
+        {
+            const std::size_t bucket = histogramBucket(v);
+            ASSERT_LE(histogramBucketLow(bucket), v);
+            ASSERT_GT(histogramBucketLow(bucket + 1), v);
+            ASSERT_LE(histogramBucketLow(bucket + 1) - histogramBucketLow(bucket), std::max<uint64_t>(1, v / 32));
+        }
+    }
+}
+
+TEST(Util, HistogramPercentiles)
+{
+    LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 100000; value++)
+        histogram.record(value);
+
+    const HistogramSnapshot snapshot = histogram.snapshot();
+    ASSERT_EQ(snapshot.count(), 100000u);
+    ASSERT_EQ(snapshot.min(), 1u);
+    ASSERT_EQ(snapshot.max(), 100000u);
+    ASSERT_DOUBLE_EQ(snapshot.mean(), 50000.5);
+    ASSERT_EQ(snapshot.percentile(0), 1u);
+    ASSERT_EQ(snapshot.percentile(100), 100000u);
+    ASSERT_NEAR(snapshot.percentile(50), 50000, 50000 / 32);
+    ASSERT_NEAR(snapshot.percentile(99), 99000, 99000 / 32);
+    ASSERT_NEAR(snapshot.percentile(99.9), 99900, 99900 / 32);
+
+    ASSERT_EQ(HistogramSnapshot().percentile(50), 0u);
+}
+
+TEST(Util, HistogramThreads)
+{
+    LatencyHistogram histogram;
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&histogram, t]
+        {
+            for (uint64_t i = 0; i < 100000; i++)
+                histogram.record(t * 1000 + i % 1000);
+        });
+    }
+
+    // Snapshots while recording see some of it
+    uint64_t seen = 0;
+    for (int i = 0; i < 10; i++)
+    {
+        const HistogramSnapshot snapshot = histogram.snapshot();
+        ASSERT_GE(snapshot.count(), seen);
+        seen = snapshot.count();
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    const HistogramSnapshot snapshot = histogram.snapshot();
+    ASSERT_EQ(snapshot.count(), 400000u);
+    ASSERT_EQ(snapshot.min(), 0u);
+    ASSERT_EQ(snapshot.max(), 3999u);
+}
+
+TEST(Util, HistogramMergeSerialize)
+{
+    HistogramSnapshot a, b;
+    a.add(10, 5);
+    a.add(1000000);
+    b.add(3);
+    b.add(123456789012ull, 2);
+
+    HistogramSnapshot merged = a;
+    merged.merge(b);
+    ASSERT_EQ(merged.count(), 9u);
+    ASSERT_EQ(merged.min(), 3u);
+    ASSERT_EQ(merged.max(), 123456789012ull);
+    ASSERT_EQ(merged.sum(), 50u + 1000000 + 3 + 2 * 123456789012ull);
+
+    const std::string data = merged.serialize();
+    ASSERT_LT(data.size(), 40u);
+
+    const HistogramSnapshot copy = HistogramSnapshot::deserialize(data.data(), data.size());
+    ASSERT_EQ(copy.count(), merged.count());
+    ASSERT_EQ(copy.sum(), merged.sum());
+    ASSERT_EQ(copy.min(), merged.min());
+    ASSERT_EQ(copy.max(), merged.max());
+    for (std::size_t i = 0; i < HistogramBuckets; i++)
+        ASSERT_EQ(copy.countAt(i), merged.countAt(i));
+
+    const std::string empty = HistogramSnapshot().serialize();
+    ASSERT_EQ(HistogramSnapshot::deserialize(empty.data(), empty.size()).count(), 0u);
+
+    ASSERT_THROW(HistogramSnapshot::deserialize("X", 1), ExceptionWithMessage);
+    ASSERT_THROW(HistogramSnapshot::deserialize(data.data(), data.size() - 1), ExceptionWithMessage);
+}
+
+TEST(Util, LatencyRecorder)
+{
+    LatencyHistogram histogram;
+    {
+        LatencyRecorder recorder(histogram);
+        usleep(1000);
+    }
+
+    const HistogramSnapshot snapshot = histogram.snapshot();
+    ASSERT_EQ(snapshot.count(), 1u);
+    ASSERT_GE(snapshot.min(), 1000000u);
+}
+
 TEST(Util, strKey)
 {
     const char *test0 = "";
@@ -142,3 +483,388 @@ TEST(Util, _key)
     // This is equal since _key can only test the first 4 chars
     ASSERT_EQ(test5, test4);
 }
+
+TEST(Util, CompStr)
+{
+    const NCString nc("Hello");
+    const std::string std("Hello");
+
+    ASSERT_TRUE(CompStr(nc, "Hello"));
+    ASSERT_TRUE(CompStr(std, nc));
+    ASSERT_TRUE(CompStr("Hello", std));
+    ASSERT_FALSE(CompStr(nc, "Hell"));
+    ASSERT_FALSE(CompStr(nc, "Hello!"));
+    ASSERT_FALSE(CompStr(nc, "hello"));
+
+    ASSERT_TRUE(ICompStr(nc, "hELLO"));
+    ASSERT_TRUE(ICompStr(std::string("HELLO"), nc));
+    ASSERT_FALSE(ICompStr(nc, "hELL"));
+    ASSERT_FALSE(ICompStr("@[`{", "`{@["));
+}
+
+TEST(Util, asciiCaseEqual)
+{
+    // Every byte against every byte, lined up over the vector and scalar parts
+    std::string a, b;
+    for (int i = 0; i < 256; i++)
+    {
+        for (int j = 0; j < 256; j++)
+        {
+            a += char(i);
+            b += char(j);
+        }
+    }
+
+    for (std::size_t offset = 0; offset < a.size(); offset += 37)
+    {
+        const std::size_t length = std::min<std::size_t>(70, a.size() - offset);
+        bool expected = true;
+        for (std::size_t k = 0; k < length; k++)
+        {
+            // <cctype> takes unsigned char values only
+            const unsigned char ca = a[offset + k], cb = b[offset + k];
+            if (ca != cb && !(isalpha(ca) && tolower(ca) == tolower(cb)))
+                expected = false;
+        }
+        ASSERT_EQ(expected, asciiCaseEqual(a.data() + offset, b.data() + offset, length)) << offset;
+    }
+
+    const std::string upper = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    const std::string lower = "abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz";
+    ASSERT_TRUE(asciiCaseEqual(upper.data(), lower.data(), upper.size()));
+    ASSERT_FALSE(asciiCaseEqual(upper.data(), (lower.substr(0, 60) + "yX").data(), upper.size()));
+}
+
+TEST(Util, KeywordSet)
+{
+    static constexpr KeywordSet<5> keywords = { "http", "https", "tcp", "udp", "Content-Length" };
+    static_assert(keywords.size() == 5, "");
+
+    ASSERT_EQ(0, keywords.match("http", 4));
+    ASSERT_EQ(1, keywords.match("HTTPS", 5));
+    ASSERT_EQ(2, keywords.match("Tcp", 3));
+    ASSERT_EQ(3, keywords.match("udp", 3));
+    ASSERT_EQ(4, keywords.match("content-length", 14));
+    ASSERT_EQ(-1, keywords.match("content-lengtX", 14));
+    ASSERT_EQ(-1, keywords.match("htt", 3));
+    ASSERT_EQ(-1, keywords.match("httpss", 6));
+    ASSERT_EQ(-1, keywords.match("", 0));
+    ASSERT_EQ(-1, keywords.match("ud\xf0", 3));
+}
+
+TEST(Util, KeywordSetCaseSensitive)
+{
+    static constexpr KeywordSet<24, true> commands = {
+        "GET", "HEAD", "POST", "PUT", "DELETE", "CONNECT", "OPTIONS", "TRACE", "PATCH", "reload", "restart", "stop",
+        "start", "status", "stats", "flush", "dump", "quit", "exit", "help", "version", "subscribe", "unsubscribe", "ping" };
+
+    ASSERT_EQ(0, commands.match("GET", 3));
+    ASSERT_EQ(-1, commands.match("get", 3));
+    ASSERT_EQ(8, commands.match("PATCH", 5));
+    ASSERT_EQ(13, commands.match("status", 6));
+    ASSERT_EQ(14, commands.match("stats", 5));
+    ASSERT_EQ(22, commands.match("unsubscribe", 11));
+    ASSERT_EQ(23, commands.match(StringView("ping")));
+    ASSERT_EQ(-1, commands.match("pong", 4));
+    ASSERT_EQ(-1, commands.match("", 0));
+}
+
+TEST(Util, strHash)
+{
+    static_assert("https"_hash != "http"_hash, "");
+    static_assert("https"_hash == strHash("https", 5), "");
+    static_assert(striHash("HTTPS", 5) == "https"_hash, "");
+
+    ASSERT_EQ("Content-Length"_hash, stringHash("Content-Length", 14));
+    ASSERT_EQ(striHash("Content-Length", 14), stringHashLower("CONTENT-length", 14));
+    ASSERT_EQ(""_hash, stringHash("", 0));
+
+    const std::string cmd = "reload";
+    switch (stringHash(cmd.data(), cmd.size()))
+    {
+        case "restart"_hash:
+            FAIL();
+        case "reload"_hash:
+            break;
+        default:
+            FAIL();
+    }
+}
+
+TEST(Util, strip)
+{
+    ASSERT_EQ(StringView("Hello World"), strip("  \t Hello World \r\n"));
+    ASSERT_EQ(StringView("Hello"), strip("Hello"));
+    ASSERT_EQ(StringView("H"), strip(" H"));
+    ASSERT_EQ(StringView(), strip(" \t\n\v\f\r"));
+    ASSERT_EQ(StringView(), strip(""));
+    ASSERT_EQ(StringView("Hello  "), stripLeft("  Hello  "));
+    ASSERT_EQ(StringView("  Hello"), stripRight("  Hello  "));
+    ASSERT_EQ(StringView("Hello"), strip("--Hello-+", "-+"));
+
+    // Long padding like ncurses form fields, over the vector code paths
+    const std::string padded = std::string(70, ' ') + "Hello  World" + std::string(90, ' ');
+    const StringView stripped = strip(padded);
+    ASSERT_EQ(StringView("Hello  World"), stripped);
+    ASSERT_EQ(padded.data() + 70, stripped.data());
+
+    ASSERT_EQ("Hello", stringStrip("  Hello "));
+    ASSERT_EQ("", stringStrip("   "));
+}
+
+TEST(Util, split)
+{
+    std::vector<std::string> fields;
+    for (StringView field : split("a,,bc,", ','))
+        fields.push_back(std::string(field.data(), field.size()));
+    ASSERT_EQ((std::vector<std::string>{ "a", "", "bc", "" }), fields);
+
+    fields.clear();
+    for (StringView field : split("", ','))
+        fields.push_back(std::string(field.data(), field.size()));
+    ASSERT_EQ((std::vector<std::string>{ "" }), fields);
+
+    fields.clear();
+    for (StringView token : tokenize("  key =\tvalue  with spaces\n"))
+        fields.push_back(std::string(token.data(), token.size()));
+    ASSERT_EQ((std::vector<std::string>{ "key", "=", "value", "with", "spaces" }), fields);
+
+    fields.clear();
+    Tokenizer tokenizer("a=1;;b=2;", ";=");
+    StringView token;
+    while (tokenizer.next(token))
+        fields.push_back(std::string(token.data(), token.size()));
+    ASSERT_EQ((std::vector<std::string>{ "a", "1", "b", "2" }), fields);
+
+    fields.clear();
+    for (StringView line : lines("first\r\nsecond\n\nlast"))
+        fields.push_back(std::string(line.data(), line.size()));
+    ASSERT_EQ((std::vector<std::string>{ "first", "second", "", "last" }), fields);
+
+    fields.clear();
+    for (StringView line : lines("one\ntwo\n"))
+        fields.push_back(std::string(line.data(), line.size()));
+    ASSERT_EQ((std::vector<std::string>{ "one", "two" }), fields);
+}
+
+TEST(Util, findNotOf)
+{
+    std::string text;
+    for (int i = 0; i < 100; i++)
+        text += " \t"[i % 2];
+
+    for (std::size_t pos = 0; pos < text.size(); pos += 7)
+    {
+        std::string t = text;
+        t[pos] = 'x';
+        ASSERT_EQ(t.data() + t.find_first_not_of(" \t"), findFirstNotOf(t.data(), t.size(), " \t", 2));
+        ASSERT_EQ(t.data() + t.find_last_not_of(" \t"), findLastNotOf(t.data(), t.size(), " \t", 2));
+
+        // Sets too big for the vector code
+        const char* big = " \tabcdefghijklmnopqrstuvw";
+        ASSERT_EQ(t.data() + pos, findFirstNotOf(t.data(), t.size(), big, strlen(big)));
+        ASSERT_EQ(t.data() + pos, findLastNotOf(t.data(), t.size(), big, strlen(big)));
+    }
+
+    ASSERT_EQ(nullptr, findFirstNotOf(text.data(), text.size(), " \t", 2));
+    ASSERT_EQ(nullptr, findLastNotOf(text.data(), text.size(), " \t", 2));
+}
+
+TEST(Util, getDate)
+{
+    // 'YYYY-MM-DD HH:MM:SS'
+    const std::string sql = getDate(dfSQL);
+    ASSERT_EQ(21u, sql.size());
+    ASSERT_EQ('\'', sql[0]);
+    ASSERT_EQ('-', sql[5]);
+    ASSERT_EQ('-', sql[8]);
+    ASSERT_EQ(' ', sql[11]);
+    ASSERT_EQ(':', sql[14]);
+    ASSERT_EQ(':', sql[17]);
+    ASSERT_EQ('\'', sql[20]);
+
+    const std::string compact = getDate(dfCompact);
+    ASSERT_EQ(14u, compact.size());
+    for (char c : compact)
+        ASSERT_TRUE(isdigit(c)) << compact;
+
+    struct tm tm = {};
+    tm.tm_year = 2026 - 1900;
+    tm.tm_mon = 0;
+    tm.tm_mday = 9;
+    tm.tm_hour = 7;
+    tm.tm_min = 5;
+    tm.tm_sec = 3;
+
+    char buffer[32];
+    ASSERT_EQ("2026-01-09 07:05:03", std::string(buffer, formatDateTime(buffer, tm, '-', ' ', ':')));
+    ASSERT_EQ("20260109T070503", std::string(buffer, formatDateTime(buffer, tm, 0, 'T', 0)));
+}
+
+TEST(Util, TimestampCache)
+{
+    TimestampCache cache(TimestampCache::tzUTC, '-', ' ', ':');
+    char buffer[TimestampCache::MaxLength];
+
+    for (int i = 0; i < 3; i++)
+    {
+        const time_t before = time(nullptr);
+        const std::string text(buffer, cache.format(buffer));
+        const time_t after = time(nullptr);
+
+        // The coarse clock may lag time() a little around the tick
+        bool found = false;
+        for (time_t t = before - 1; t <= after && !found; t++)
+        {
+            struct tm tm;
+            gmtime_r(&t, &tm);
+            char expected[32];
+            found = text == std::string(expected, formatDateTime(expected, tm, '-', ' ', ':'));
+        }
+        ASSERT_TRUE(found) << text;
+    }
+
+    std::string ms(buffer, cache.format(buffer, tpMilliseconds));
+    ASSERT_EQ(cache.length(tpMilliseconds), ms.size());
+    ASSERT_EQ('.', ms[19]);
+    for (std::size_t i = 20; i < ms.size(); i++)
+        ASSERT_TRUE(isdigit(ms[i])) << ms;
+
+    std::string us(buffer, cache.format(buffer, tpMicroseconds));
+    ASSERT_EQ(cache.length(tpMicroseconds), us.size());
+    ASSERT_EQ(TimestampCache::MaxLength, us.size());
+    ASSERT_EQ('.', us[19]);
+    for (std::size_t i = 20; i < us.size(); i++)
+        ASSERT_TRUE(isdigit(us[i])) << us;
+
+    TimestampCache compact(TimestampCache::tzLocal, 0, 'T', 0);
+    ASSERT_EQ(15u, compact.length());
+    ASSERT_EQ(compact.length(), static_cast<std::size_t>(compact.format(buffer) - buffer));
+    ASSERT_EQ('T', buffer[8]);
+
+    // All threads see the same text, whoever formatted it
+    std::vector<std::thread> threads;
+    std::atomic<int> mismatches(0);
+    for (int t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&]
+        {
+            char local[TimestampCache::MaxLength];
+            for (int i = 0; i < 100000; i++)
+            {
+                const std::size_t len = cache.format(local) - local;
+                if (len != 19 || local[4] != '-' || local[13] != ':')
+                    mismatches++;
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+    ASSERT_EQ(0, mismatches.load());
+}
+
+TEST(Util, parseCpuList)
+{
+    std::vector<int> cpus;
+    ASSERT_TRUE(parseCpuList("0-3,8,10-11\n", cpus));
+    ASSERT_EQ((std::vector<int>{0, 1, 2, 3, 8, 10, 11}), cpus);
+    ASSERT_TRUE(parseCpuList("5", cpus));
+    ASSERT_EQ(std::vector<int>{5}, cpus);
+    ASSERT_TRUE(parseCpuList("", cpus));
+    ASSERT_TRUE(cpus.empty());
+
+    ASSERT_FALSE(parseCpuList("3-1", cpus));
+    ASSERT_FALSE(parseCpuList("0-", cpus));
+    ASSERT_FALSE(parseCpuList("0;1", cpus));
+}
+
+TEST(Util, CpuTopology)
+{
+    const CpuTopology& topology = CpuTopology::instance();
+
+    ASSERT_EQ(sysconf(_SC_NPROCESSORS_ONLN), topology.onlineCpus());
+    ASSERT_EQ(topology.onlineCpus(), getNumCores());
+    ASSERT_LE(topology.cores(), topology.onlineCpus());
+    ASSERT_GE(topology.cores(), topology.packages());
+    ASSERT_GE(topology.numaNodes(), 1);
+    ASSERT_EQ(static_cast<std::size_t>(topology.cores()), topology.firstCpuOfEachCore().size());
+    ASSERT_EQ(static_cast<std::size_t>(sysconf(_SC_PAGESIZE)), getSystemPageSize());
+
+    const std::vector<int> siblings = topology.siblings(topology.cpus().front().id);
+    ASSERT_FALSE(siblings.empty());
+    ASSERT_EQ(topology.cpus().front().id, siblings.front());
+
+    ASSERT_GE(CpuTopology::availableCpus(), 1);
+    ASSERT_LE(CpuTopology::availableCpus(), topology.configuredCpus());
+    ASSERT_GE(topology.cacheLineSize(), 16u);
+}
+
+// A made up machine: two packages of two cores with two threads each, one node per package
+TEST(Util, CpuTopologySysfs)
+{
+    char root[] = "/tmp/bftopologyXXXXXX";
+    ASSERT_NE(nullptr, mkdtemp(root));
+    const std::string base = root;
+
+    auto write = [&](const std::string& path, const std::string& text)
+    {
+        std::size_t pos = 0;
+        while ((pos = path.find('/', pos + 1)) != std::string::npos)
+            mkdir((base + path.substr(0, pos)).c_str(), 0700);
+        std::ofstream(base + path) << text << "\n";
+    };
+
+    write("/cpu/online", "0-7");
+    write("/cpu/present", "0-15");
+    for (int cpu = 0; cpu < 8; cpu++)
+    {
+        const std::string dir = "/cpu/cpu" + std::to_string(cpu) + "/topology/";
+        write(dir + "physical_package_id", std::to_string(cpu / 4));
+        write(dir + "core_id", std::to_string(cpu % 2));
+    }
+    write("/node/online", "0-1");
+    write("/node/node0/cpulist", "0-3");
+    write("/node/node1/cpulist", "4-7");
+    write("/cpu/cpu0/cache/index0/level", "1");
+    write("/cpu/cpu0/cache/index0/type", "Instruction");
+    write("/cpu/cpu0/cache/index0/size", "32K");
+    write("/cpu/cpu0/cache/index1/level", "1");
+    write("/cpu/cpu0/cache/index1/type", "Data");
+    write("/cpu/cpu0/cache/index1/size", "48K");
+    write("/cpu/cpu0/cache/index1/coherency_line_size", "128");
+    write("/cpu/cpu0/cache/index2/level", "2");
+    write("/cpu/cpu0/cache/index2/type", "Unified");
+    write("/cpu/cpu0/cache/index2/size", "2M");
+    write("/cpu/cpu0/cache/index2/shared_cpu_list", "0,2");
+
+    const CpuTopology topology(base);
+    ASSERT_EQ(8, topology.onlineCpus());
+    ASSERT_EQ(16, topology.configuredCpus());
+    ASSERT_EQ(4, topology.cores());
+    ASSERT_EQ(2, topology.packages());
+    ASSERT_EQ(2, topology.threadsPerCore());
+    ASSERT_EQ(2, topology.numaNodes());
+
+    ASSERT_EQ((std::vector<int>{1, 3}), topology.siblings(3));
+    ASSERT_EQ((std::vector<int>{4, 6}), topology.siblings(4));
+    ASSERT_TRUE(topology.siblings(8).empty());
+    ASSERT_EQ((std::vector<int>{0, 1, 4, 5}), topology.firstCpuOfEachCore());
+    ASSERT_EQ((std::vector<int>{4, 5, 6, 7}), topology.nodeCpus(1));
+    ASSERT_EQ(1, topology.cpu(5)->node);
+    ASSERT_EQ(nullptr, topology.cpu(9));
+
+    ASSERT_EQ(3u, topology.caches().size());
+    ASSERT_EQ(48u * 1024, topology.cacheSize(1));
+    ASSERT_EQ(2u * 1024 * 1024, topology.cacheSize(2));
+    ASSERT_EQ(0u, topology.cacheSize(3));
+    ASSERT_EQ(128u, topology.cacheLineSize());
+    ASSERT_EQ(2, topology.caches()[2].sharedCpus);
+
+    system(("rm -rf " + base).c_str());
+
+    // Nothing there: one core per CPU from sysconf
+    const CpuTopology empty(base);
+    ASSERT_EQ(sysconf(_SC_NPROCESSORS_ONLN), empty.onlineCpus());
+    ASSERT_EQ(empty.onlineCpus(), empty.cores());
+    ASSERT_EQ(1, empty.numaNodes());
+}